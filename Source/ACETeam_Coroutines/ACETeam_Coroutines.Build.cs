@@ -35,7 +35,9 @@ public class ACETeam_Coroutines : ModuleRules
 			new string[]
 			{
 				"CoreUObject",
+				"AssetRegistry",
 				"Engine",
+				"NavigationSystem",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -0,0 +1,183 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineAssetRegistry.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/Async.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		static IAssetRegistry& GetAssetRegistry()
+		{
+			return FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		}
+
+#if ENGINE_MAJOR_VERSION == 4
+		//Splits the filter into smaller ones whose results add up to the same assets. The results of each one are
+		//OR'ed, so only one of the fields can be split: package paths first, expanding recursive ones, or else classes
+		static TArray<FARFilter> SplitFilter(IAssetRegistry& Registry, FARFilter const& Filter)
+		{
+			TArray<FARFilter> Filters;
+			if (Filter.PackagePaths.Num() > 0)
+			{
+				TSet<FName> Paths;
+				for (FName Path : Filter.PackagePaths)
+				{
+					Paths.Add(Path);
+					if (Filter.bRecursivePaths)
+					{
+						TArray<FString> SubPaths;
+						Registry.GetSubPaths(Path.ToString(), SubPaths, true);
+						for (FString const& SubPath : SubPaths)
+						{
+							Paths.Add(FName(*SubPath));
+						}
+					}
+				}
+				for (FName Path : Paths)
+				{
+					FARFilter& Split = Filters.Add_GetRef(Filter);
+					Split.PackagePaths = { Path };
+					Split.bRecursivePaths = false;
+				}
+			}
+			else if (Filter.ClassNames.Num() > 1)
+			{
+				for (FName ClassName : Filter.ClassNames)
+				{
+					FARFilter& Split = Filters.Add_GetRef(Filter);
+					Split.ClassNames = { ClassName };
+				}
+			}
+			else
+			{
+				Filters.Add(Filter);
+			}
+			return Filters;
+		}
+#endif
+
+		TSharedRef<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe> FAsyncAssetRegistryQuery::Start(FARFilter const& Filter, FOnFinished const& OnFinished)
+		{
+			check(IsInGameThread());
+			TSharedRef<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe> Query = MakeShareable(new FAsyncAssetRegistryQuery(Filter, OnFinished));
+			IAssetRegistry& Registry = GetAssetRegistry();
+			if (Registry.IsLoadingAssets())
+			{
+				TWeakPtr<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe> WeakQuery = Query;
+				Query->FilesLoadedHandle = Registry.OnFilesLoaded().AddLambda([WeakQuery]
+				{
+					if (auto PinnedQuery = WeakQuery.Pin())
+					{
+						GetAssetRegistry().OnFilesLoaded().Remove(PinnedQuery->FilesLoadedHandle);
+						PinnedQuery->FilesLoadedHandle.Reset();
+						PinnedQuery->Launch();
+					}
+				});
+			}
+			else
+			{
+				Query->Launch();
+			}
+			return Query;
+		}
+
+		FAsyncAssetRegistryQuery::FAsyncAssetRegistryQuery(FARFilter const& InFilter, FOnFinished const& InOnFinished)
+			: Filter(InFilter)
+			, OnFinished(InOnFinished)
+		{
+			//in-memory assets can only be searched on the game thread
+			Filter.bIncludeOnlyOnDiskAssets = true;
+		}
+
+		FAsyncAssetRegistryQuery::~FAsyncAssetRegistryQuery()
+		{
+			if (FilesLoadedHandle.IsValid())
+			{
+				GetAssetRegistry().OnFilesLoaded().Remove(FilesLoadedHandle);
+			}
+#if ENGINE_MAJOR_VERSION == 4
+			if (TickerHandle.IsValid())
+			{
+				FTicker::GetCoreTicker().RemoveTicker(TickerHandle);
+			}
+#endif
+		}
+
+		void FAsyncAssetRegistryQuery::Launch()
+		{
+			IAssetRegistry* Registry = &GetAssetRegistry();
+			TWeakPtr<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe> WeakThis = AsShared();
+#if ENGINE_MAJOR_VERSION == 4
+			//the registry can't be read from other threads before UE5, so the query is spread across frames instead
+			SplitFilters = SplitFilter(*Registry, Filter);
+			TickerHandle = FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([WeakThis](float)
+			{
+				auto This = WeakThis.Pin();
+				return This.IsValid() && This->RunNextFilter();
+			}));
+#else
+			AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [Registry, WeakThis, Filter = Filter]
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(FAsyncAssetRegistryQuery::GetAssets);
+				TArray<FAssetData> Assets;
+				Registry->GetAssets(Filter, Assets);
+				AsyncTask(ENamedThreads::GameThread, [WeakThis, Assets = MoveTemp(Assets)]
+				{
+					if (auto This = WeakThis.Pin())
+					{
+						This->Finish(Assets);
+					}
+				});
+			});
+#endif
+		}
+
+#if ENGINE_MAJOR_VERSION == 4
+		bool FAsyncAssetRegistryQuery::RunNextFilter()
+		{
+			if (!OnFinished)
+			{
+				TickerHandle.Reset();
+				return false;
+			}
+			TRACE_CPUPROFILER_EVENT_SCOPE(FAsyncAssetRegistryQuery::GetAssets);
+			TArray<FAssetData> Assets;
+			GetAssetRegistry().GetAssets(SplitFilters[NextFilter++], Assets);
+			for (FAssetData& Asset : Assets)
+			{
+				bool bAlreadyGathered = false;
+				GatheredObjectPaths.Add(Asset.ObjectPath, &bAlreadyGathered);
+				if (!bAlreadyGathered)
+				{
+					GatheredAssets.Add(MoveTemp(Asset));
+				}
+			}
+			if (NextFilter < SplitFilters.Num())
+				return true;
+			TickerHandle.Reset();
+			Finish(GatheredAssets);
+			return false;
+		}
+#endif
+
+		void FAsyncAssetRegistryQuery::Finish(TArray<FAssetData> const& Assets)
+		{
+			//move it out first, the callback is likely to release the last reference to this query
+			FOnFinished Callback = MoveTemp(OnFinished);
+			OnFinished = nullptr;
+			if (Callback)
+			{
+				Callback(Assets);
+			}
+		}
+
+		void FAsyncAssetRegistryQuery::Cancel()
+		{
+			check(IsInGameThread());
+			OnFinished = nullptr;
+		}
+	}
+}
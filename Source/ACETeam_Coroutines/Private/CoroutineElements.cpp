@@ -4,11 +4,33 @@
 
 #include "CoroutineExecutor.h"
 #include "CoroutineLog.h"
+#include "HAL/IConsoleManager.h"
+
+static int32 GSequencePrefetchLookahead = 1;
+static FAutoConsoleVariableRef SequencePrefetchLookaheadCVar (TEXT("ace.SequencePrefetchLookahead"), GSequencePrefetchLookahead, TEXT("How many children ahead of the running one a sequence asks to prefetch. Zero disables prefetching"));
 
 namespace ACETeam_Coroutines
 {
 namespace Detail
 {
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	uint32 FNamedScopeNode::GetCpuTraceSpecId() const
+	{
+		if (CpuTraceSpecId == 0)
+		{
+			//scopes are created far more often than new names show up, so specs are registered once per name
+			static TMap<FName, uint32> SpecIdsByName;
+			uint32& SpecId = SpecIdsByName.FindOrAdd(InternedName);
+			if (SpecId == 0)
+			{
+				SpecId = FCpuProfilerTrace::OutputEventType(*Name);
+			}
+			CpuTraceSpecId = SpecId;
+		}
+		return CpuTraceSpecId;
+	}
+#endif
+
 	void FCompositeCoroutine::AddChild( FCoroutineNodeRef const& Child )
 	{
 		m_Children.Add(Child);
@@ -28,7 +50,12 @@ namespace Detail
 		if (m_Children.Num() == 0)
 			return Completed;
 		m_CurChild = 0;
-		Exec->EnqueueCoroutineNode(m_Children[m_CurChild++], this);
+		//the children after the first one only enter the lookahead window here
+		for (int32 i = 1; i < GSequencePrefetchLookahead && i < m_Children.Num(); ++i)
+		{
+			m_Children[i]->Prefetch();
+		}
+		StartNextChild(Exec);
 		return Suspended;
 	}
 
@@ -42,10 +69,28 @@ namespace Detail
 		{
 			return Completed;
 		}
-		Exec->EnqueueCoroutineNode(m_Children[m_CurChild++], this);
+		StartNextChild(Exec);
 		return Suspended;
 	}
 
+	void FSequence::StartNextChild(FCoroutineExecutor* Exec)
+	{
+		const int32 PrefetchIndex = m_CurChild + GSequencePrefetchLookahead;
+		if (GSequencePrefetchLookahead > 0 && PrefetchIndex < m_Children.Num())
+		{
+			m_Children[PrefetchIndex]->Prefetch();
+		}
+		Exec->EnqueueCoroutineNode(m_Children[m_CurChild++], this);
+	}
+
+	void FSequence::Prefetch()
+	{
+		if (m_Children.Num() > 0)
+		{
+			m_Children[0]->Prefetch();
+		}
+	}
+
 	EStatus FOptionalSequence::OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child)
 	{
 		//don't propagate failure
@@ -112,6 +157,12 @@ namespace Detail
 		return Suspended;
 	}
 
+	void FParallelBase::Prefetch()
+	{
+		for (auto& Child : m_Children)
+			Child->Prefetch();
+	}
+
 	void FParallelBase::AbortOtherBranches( FCoroutineNode* Child, FCoroutineExecutor* Exec )
 	{
 		for (int i = m_Children.Num()-1; i >= 0; --i)
@@ -140,6 +191,12 @@ namespace Detail
 		return Suspended;
 	}
 
+	void FCoroutineDecorator::Prefetch()
+	{
+		if (m_Child)
+			m_Child->Prefetch();
+	}
+
 	void FCoroutineDecorator::AddChild(FCoroutineNodeRef const& Child)
 	{
 #if DO_CHECK
@@ -48,7 +48,7 @@ namespace ACETeam_Coroutines
 		{
 			if (CachedExec)
 			{
-				CachedExec->ForceNodeEnd(this, Completed);
+				CachedExec->ForceNodeEnd(this, Completed, EWakeSource::Event);
 			}
 		}
 
@@ -56,7 +56,7 @@ namespace ACETeam_Coroutines
 		{
 			if (CachedExec)
 			{
-				CachedExec->ForceNodeEnd(this, Failed);
+				CachedExec->ForceNodeEnd(this, Failed, EWakeSource::Event);
 			}
 		}
 	}
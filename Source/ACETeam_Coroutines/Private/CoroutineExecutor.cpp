@@ -2,8 +2,12 @@
 #include "CoroutineExecutor.h"
 
 #include "CoroutineElements.h"
+#include "CoroutineExecutorStats.h"
+#include "CoroutineInsightsTrace.h"
+#include "CoroutineScopeCostInternal.h"
+#include "CoroutineWakeLatency.h"
 #include "Algo/Find.h"
-#include "Algo/RemoveIf.h"
+#include "HAL/IConsoleManager.h"
 #include "Misc/ScopeExit.h"
 
 const TCHAR* ACETeam_Coroutines::ToString(EStatus Status)
@@ -20,7 +24,111 @@ const TCHAR* ACETeam_Coroutines::ToString(EStatus Status)
 	return TEXT("<INVALID>");
 }
 
+const TCHAR* ACETeam_Coroutines::ToString(EWakeSource Source)
+{
+	switch (Source)
+	{
+	case EWakeSource::None: return TEXT("None");
+	case EWakeSource::Event: return TEXT("Event");
+	case EWakeSource::Async: return TEXT("Async");
+	case EWakeSource::Streaming: return TEXT("Streaming");
+	case EWakeSource::Semaphore: return TEXT("Semaphore");
+	case EWakeSource::Lock: return TEXT("Lock");
+	case EWakeSource::RateLimit: return TEXT("RateLimit");
+	default: break;
+	}
+	check(false);
+	return TEXT("<INVALID>");
+}
+
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
+FString ACETeam_Coroutines::FCoroutineDebugName::ToString() const
+{
+	if (Pattern == nullptr)
+		return FString();
+	FString Param;
+	switch (ParamType)
+	{
+	case EParam::None: return FString(Pattern);
+	case EParam::Float: Param = FString::Printf(TEXT("%.1f"), FloatParam); break;
+	case EParam::Int: Param = FString::FromInt(IntParam); break;
+	case EParam::Name: Param = NameParam.ToString(); break;
+	}
+	return FString(Pattern).Replace(TEXT("{0}"), *Param);
+}
+#endif
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+static int32 GCoroutineDebuggerTracking = 0;
+static FAutoConsoleVariableRef CoroutineDebuggerTrackingCVar (TEXT("ace.Coroutines.DebuggerTracking"), GCoroutineDebuggerTracking, TEXT("If set, coroutine nodes are always tracked for the gameplay debugger. Otherwise they're only tracked while the Coroutines category is being drawn"));
+
+static double GCoroutineDebuggerRequestTime = -1.0;
+//How long tracking keeps running after the debugger last drew
+static const double GCoroutineDebuggerRequestTimeout = 1.0;
+
+void ACETeam_Coroutines::FCoroutineExecutor::RequestDebuggerTracking()
+{
+	GCoroutineDebuggerRequestTime = FApp::GetCurrentTime();
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::UpdateDebugTracking()
+{
+	const bool bWasTracking = bTrackForDebugger;
+	bTrackForDebugger = GCoroutineDebuggerTracking != 0 || FApp::GetCurrentTime() - GCoroutineDebuggerRequestTime < GCoroutineDebuggerRequestTimeout;
+	if (bWasTracking && !bTrackForDebugger)
+	{
+		//rows would be missing whatever happens until tracking resumes, so there's no point in keeping them
+		DebuggerRows.Empty();
+		DebuggerRowIndex.Empty();
+		DebuggerExpiryQueue.Empty();
+		FirstDebuggerRoot = INDEX_NONE;
+		LastDebuggerRoot = INDEX_NONE;
+	}
+#if CPUPROFILERTRACE_ENABLED
+	bEmitTraceScopes = UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel);
+#endif
+	bEmitLifecycleTrace = FCoroutinesTrace::IsEnabled();
+	bTrackScopeCost = Detail::IsScopeCostEnabled();
+	bTrackWakeLatency = bEmitLifecycleTrace || Detail::IsWakeLatencyEnabled();
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::TraceStepEnd()
+{
+	if (bEmitLifecycleTrace)
+	{
+		//the frame marker isn't counted as active
+		FCoroutinesTrace::OutputExecutorStep(this, StepStartCycle, m_ActiveNodes.Num() - 1, m_SuspendedNodes.Num());
+	}
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::AddScopeCost(const Detail::FNamedScopeNode* Scope, FCoroutineNode* Node, uint64 Cycles)
+{
+	bool bExclusive = true;
+	for (; Scope; Scope = Scope->ParentScope)
+	{
+		if (Scope->ScopeCostIndex == INDEX_NONE)
+		{
+			Scope->ScopeCostIndex = Detail::FindOrAddScopeCost(Scope->InternedName);
+		}
+		if (Detail::AddScopeCost(Scope->ScopeCostIndex, Cycles, bExclusive))
+		{
+			Detail::LogScopeOverrun(Scope->ScopeCostIndex, Node->Debug_GetName().ToString());
+		}
+		bExclusive = false;
+	}
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::RecordWakeLatency(FNodeExecInfo const& Info)
+{
+	const uint64 Cycles = FPlatformTime::Cycles64() - Info.WakeCycle;
+	const int32 Steps = m_StepCount - Info.WakeStep;
+	Detail::AddWakeLatency(Info.WakeSource, FPlatformTime::ToSeconds64(Cycles), Steps);
+	if (bEmitLifecycleTrace)
+	{
+		FCoroutinesTrace::OutputWakeUp(Info.Node.Get(), Info.WakeSource, Info.WakeCycle, Steps);
+	}
+}
+
 void ACETeam_Coroutines::FCoroutineExecutor::TraceScopeCleanup()
 {
 	auto CurrentScope = LastScope;
@@ -49,12 +157,11 @@ bool ACETeam_Coroutines::FCoroutineExecutor::SingleStep( float DeltaTime )
 	}
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-	if (Info.ScopeNode != LastScope)
+	if (bEmitTraceScopes && Info.ScopeNode != LastScope)
 	{
-		auto* ScopeNamePtr = Info.ScopeNode ? &Info.ScopeNode->Name : nullptr;
 		if (Info.ScopeNode && Info.ScopeNode->ParentScope == LastScope)
 		{
-			FCpuProfilerTrace::OutputBeginDynamicEvent(**ScopeNamePtr);
+			FCpuProfilerTrace::OutputBeginEvent(Info.ScopeNode->GetCpuTraceSpecId());
 			++CurrentTraceDepth;
 		}
 		else if (LastScope && Info.ScopeNode == LastScope->ParentScope)
@@ -91,17 +198,17 @@ bool ACETeam_Coroutines::FCoroutineExecutor::SingleStep( float DeltaTime )
 				FCpuProfilerTrace::OutputEndEvent();
 				--CurrentTraceDepth;
 			}
-			if (ScopeNamePtr)
+			if (Info.ScopeNode)
 			{
 				if (CurrentAncestors.Num() > 0)
 				{
 					for (int i = CurrentAncestors.Num() - 1 - CommonAncestors; i >= 0; --i)
 					{
-						FCpuProfilerTrace::OutputBeginDynamicEvent(*CurrentAncestors[i]->Name);
+						FCpuProfilerTrace::OutputBeginEvent(CurrentAncestors[i]->GetCpuTraceSpecId());
 						++CurrentTraceDepth;
 					}
 				}
-				FCpuProfilerTrace::OutputBeginDynamicEvent(**ScopeNamePtr);
+				FCpuProfilerTrace::OutputBeginEvent(Info.ScopeNode->GetCpuTraceSpecId());
 				++CurrentTraceDepth;
 			}
 			ensure(CurrentTraceDepth == CurrentAncestors.Num() + (Info.ScopeNode != nullptr));
@@ -119,10 +226,40 @@ bool ACETeam_Coroutines::FCoroutineExecutor::SingleStep( float DeltaTime )
 		return true;
 	}
 
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	//the woken up branch is resuming now
+	if (Info.WakeSource != EWakeSource::None)
+	{
+		RecordWakeLatency(Info);
+		Info.WakeSource = EWakeSource::None;
+	}
+#endif
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	//node types can ask for their evaluation to show up as an event of its own
+	const uint32 NodeCpuTraceId = bEmitTraceScopes ? Info.Node->Debug_GetCpuTraceId() : 0;
+	if (NodeCpuTraceId != 0)
+	{
+		FCpuProfilerTrace::OutputBeginEvent(NodeCpuTraceId);
+	}
+	ON_SCOPE_EXIT{
+		if (NodeCpuTraceId != 0)
+		{
+			FCpuProfilerTrace::OutputEndEvent();
+		}
+	};
+#endif
+
 	//node is just starting, let's eval its starting condition
 	if (Info.Status == None)
 	{
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		const uint64 CostStartCycle = BeginScopeCost(Info.ScopeNode);
+#endif
 		Info.Status = Info.Node->Start(this);
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		EndScopeCost(CostStartCycle, Info.ScopeNode, Info.Node.Get());
+#endif
 
 		TrackNodeStart(Info.Node.Get(), Info.Parent, Info.Status);
 
@@ -140,7 +277,13 @@ bool ACETeam_Coroutines::FCoroutineExecutor::SingleStep( float DeltaTime )
 		}
 	}
 
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	const uint64 CostStartCycle = BeginScopeCost(Info.ScopeNode);
+#endif
 	Info.Status = Info.Node->Update(this, DeltaTime);
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	EndScopeCost(CostStartCycle, Info.ScopeNode, Info.Node.Get());
+#endif
 
 	//suspended nodes get thrown into the suspended list
 	if (Info.Status == Suspended)
@@ -205,13 +348,26 @@ void ACETeam_Coroutines::FCoroutineExecutor::EnqueueCoroutine(FCoroutineNodeRef
 	EnqueueCoroutineNode(Coroutine, nullptr);
 }
 
-void ACETeam_Coroutines::FCoroutineExecutor::EnqueueCoroutineNode(FCoroutineNodeRef const& Node, FCoroutineNode* Parent)
+void ACETeam_Coroutines::FCoroutineExecutor::EnqueueCoroutineNode(FCoroutineNodeRef const& Node, FCoroutineNode* Parent, EWakeSource WakeSource)
 {
 	FNodeExecInfo CoroutineInfo;
 	CoroutineInfo.Node = Node;
 	CoroutineInfo.Parent = Parent;
 	CoroutineInfo.Status = static_cast<EStatus>(None);
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
+	if (bTrackWakeLatency && WakeSource != EWakeSource::None)
+	{
+		CoroutineInfo.WakeSource = WakeSource;
+		CoroutineInfo.WakeStep = m_StepCount;
+		CoroutineInfo.WakeCycle = FPlatformTime::Cycles64();
+	}
+	else if (PendingWakeSource != EWakeSource::None)
+	{
+		//a parent reacting to a ForceNodeEnd (e.g. a sequence starting its next child) resumes the waiting branch here
+		CoroutineInfo.WakeSource = PendingWakeSource;
+		CoroutineInfo.WakeStep = m_StepCount;
+		CoroutineInfo.WakeCycle = PendingWakeCycle;
+	}
 	const FNodeExecInfo* ParentInfo = nullptr;
 	if (Parent)
 	{
@@ -253,7 +409,15 @@ void ACETeam_Coroutines::FCoroutineExecutor::ProcessNodeEnd( FNodeExecInfo& Info
 	TrackNodeEnd(Info.Node.Get(), Status);
 	if (Info.Parent)
 	{
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		//a scope node's own scope is itself, while its parent is in the scope around it
+		Detail::FNamedScopeNode* ParentScope = Info.ScopeNode && Info.ScopeNode == Info.Node.Get() ? Info.ScopeNode->ParentScope : Info.ScopeNode;
+		const uint64 CostStartCycle = BeginScopeCost(ParentScope);
+#endif
 		Status = Info.Parent->OnChildStopped(this, Status, Info.Node.Get());
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		EndScopeCost(CostStartCycle, ParentScope, Info.Parent);
+#endif
 		if (Status != Suspended)
 		{
 			if (FNodeExecInfo* ParentInfo = m_SuspendedNodes.FindByPredicate(NodeIs(Info.Parent)))
@@ -261,8 +425,22 @@ void ACETeam_Coroutines::FCoroutineExecutor::ProcessNodeEnd( FNodeExecInfo& Info
 				if (Status == Running)
 				{
 					//reactivated node
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+					if (bEmitLifecycleTrace)
+					{
+						FCoroutinesTrace::OutputNodeResume(Info.Parent);
+					}
+#endif
 					m_ActiveNodes.Add(MoveTemp(*ParentInfo));
 					m_ActiveNodes.Last().Status = Running;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+					if (PendingWakeSource != EWakeSource::None)
+					{
+						m_ActiveNodes.Last().WakeSource = PendingWakeSource;
+						m_ActiveNodes.Last().WakeStep = m_StepCount;
+						m_ActiveNodes.Last().WakeCycle = PendingWakeCycle;
+					}
+#endif
 					ParentInfo->Status = Aborted;
 					//won't erase info immediately to avoid invalidating iterator
 					//but node pointer was moved, so it won't be confused with
@@ -297,30 +475,46 @@ void ACETeam_Coroutines::FCoroutineExecutor::Cleanup()
 	m_SuspendedNodes.RemoveAllSwap(Pred);
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
+	const double DropTime = FApp::GetCurrentTime() - 60.0f;
+	if (DebuggerExpiryQueue.Num() > 0 && DebuggerExpiryQueue.First().EndTime < DropTime)
 	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(DebuggerEntryDrop);
+		do
 		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(DebuggerEntryDrop);
-			const double DropTime = FApp::GetCurrentTime() - 60.0f;
-			for (auto RowIt = DebuggerInfo.CreateIterator(); RowIt; ++RowIt)
+			const int32 RowIndex = DebuggerExpiryQueue.First().RowIndex;
+			DebuggerExpiryQueue.PopFront();
+			//the row may have been removed or reused since, or its entry reopened by coalescing, so check what's actually expired
+			if (!DebuggerRows.IsAllocated(RowIndex))
+				continue;
+			FDebuggerRow& Row = DebuggerRows[RowIndex];
+			while (Row.Entries.Num() > 0 && Row.Entries.First().EndTime >= 0.0f && Row.Entries.First().EndTime < DropTime)
 			{
-				while (RowIt->Entries.Num() > 0 && RowIt->Entries.First().EndTime >= 0.0f && RowIt->Entries.First().EndTime < DropTime)
-				{
-					RowIt->Entries.PopFront();
-				}
+				Row.Entries.PopFront();
 			}
-		}
-		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(DebuggerRowDrop);
-			const int32 NewEnd = Algo::StableRemoveIf(DebuggerInfo, [](FDebuggerRow const& Row)
+			if (Row.Entries.Num() == 0)
 			{
-				return Row.Entries.Num() == 0;
-			});
-			DebuggerInfo.SetNum(NewEnd);
-		}
+				RemoveDebuggerRow(RowIndex);
+			}
+		} while (DebuggerExpiryQueue.Num() > 0 && DebuggerExpiryQueue.First().EndTime < DropTime);
 	}
 #endif
 }
 
+void ACETeam_Coroutines::FCoroutineExecutor::FinishStepStats()
+{
+	FStepStats& Stats = CurrentStepStats;
+	Stats.StepTimeSeconds = FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - StepStartCycle);
+	//the frame marker isn't counted as active
+	Stats.NumActive = m_ActiveNodes.Num() - 1;
+	Stats.NumSuspended = m_SuspendedNodes.Num();
+	Stats.ActiveCapacity = m_ActiveNodes.Max();
+	Stats.SuspendedCapacity = m_SuspendedNodes.Max();
+	Stats.Reallocations = (Stats.ActiveCapacity != LastStepStats.ActiveCapacity) + (Stats.SuspendedCapacity != LastStepStats.SuspendedCapacity);
+	LastStepStats = Stats;
+	CurrentStepStats = FStepStats();
+	Detail::PublishExecutorStepStats(LastStepStats);
+}
+
 void ACETeam_Coroutines::FCoroutineExecutor::AbortNode( FCoroutineNode* Node )
 {
 	if (!Node)
@@ -363,9 +557,14 @@ void ACETeam_Coroutines::FCoroutineExecutor::AbortNode( FCoroutineNode* Node )
 #endif
 }
 
-void ACETeam_Coroutines::FCoroutineExecutor::ForceNodeEnd( FCoroutineNode* Node, EStatus Status )
+void ACETeam_Coroutines::FCoroutineExecutor::ForceNodeEnd( FCoroutineNode* Node, EStatus Status, EWakeSource WakeSource )
 {
 	check(IsFinished(Status));
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	//the waiting branch resumes when ending this node reactivates one of its ancestors or makes one enqueue a child, see ProcessNodeEnd and EnqueueCoroutineNode
+	TGuardValue<EWakeSource> WakeSourceGuard(PendingWakeSource, bTrackWakeLatency ? WakeSource : EWakeSource::None);
+	TGuardValue<uint64> WakeCycleGuard(PendingWakeCycle, PendingWakeSource != EWakeSource::None ? FPlatformTime::Cycles64() : 0);
+#endif
 	FNodeExecInfo* Info;
 	Info = m_SuspendedNodes.FindByPredicate(NodeIs(Node));
 	if (Info)
@@ -386,49 +585,188 @@ void ACETeam_Coroutines::FCoroutineExecutor::ForceNodeEnd( FCoroutineNode* Node,
 	}
 }
 
-void ACETeam_Coroutines::FCoroutineExecutor::TrackNodeStart(FCoroutineNode* Node, FCoroutineNode* Parent, EStatus Status)
-{
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
+int32 ACETeam_Coroutines::FCoroutineExecutor::FindDebuggerRow(FCoroutineNode* Node) const
+{
+	const int32* RowIndex = DebuggerRowIndex.Find(Node);
+	return RowIndex ? *RowIndex : INDEX_NONE;
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::LinkDebuggerRow(int32 RowIndex, int32 ParentRow)
+{
+	FDebuggerRow& Row = DebuggerRows[RowIndex];
+	Row.ParentRow = ParentRow;
+	if (ParentRow == INDEX_NONE)
+	{
+		//roots are shown in the order they started
+		Row.PrevSibling = LastDebuggerRoot;
+		Row.NextSibling = INDEX_NONE;
+		if (LastDebuggerRoot != INDEX_NONE)
+		{
+			DebuggerRows[LastDebuggerRoot].NextSibling = RowIndex;
+		}
+		else
+		{
+			FirstDebuggerRoot = RowIndex;
+		}
+		LastDebuggerRoot = RowIndex;
+	}
+	else
+	{
+		//children are shown right below their parent, the most recent first
+		FDebuggerRow& Parent = DebuggerRows[ParentRow];
+		Row.PrevSibling = INDEX_NONE;
+		Row.NextSibling = Parent.FirstChild;
+		if (Parent.FirstChild != INDEX_NONE)
+		{
+			DebuggerRows[Parent.FirstChild].PrevSibling = RowIndex;
+		}
+		else
+		{
+			Parent.LastChild = RowIndex;
+		}
+		Parent.FirstChild = RowIndex;
+	}
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::RemoveDebuggerRow(int32 RowIndex)
+{
+	FDebuggerRow& Row = DebuggerRows[RowIndex];
+	int32& FirstInList = Row.ParentRow != INDEX_NONE ? DebuggerRows[Row.ParentRow].FirstChild : FirstDebuggerRoot;
+	int32& LastInList = Row.ParentRow != INDEX_NONE ? DebuggerRows[Row.ParentRow].LastChild : LastDebuggerRoot;
+	//children that outlive the row take its place in the list of its siblings
+	int32 First = Row.FirstChild;
+	int32 Last = Row.LastChild;
+	if (First != INDEX_NONE)
+	{
+		for (int32 Child = First; Child != INDEX_NONE; Child = DebuggerRows[Child].NextSibling)
+		{
+			DebuggerRows[Child].ParentRow = Row.ParentRow;
+		}
+		DebuggerRows[First].PrevSibling = Row.PrevSibling;
+		DebuggerRows[Last].NextSibling = Row.NextSibling;
+	}
+	else
+	{
+		First = Row.NextSibling;
+		Last = Row.PrevSibling;
+	}
+	if (Row.PrevSibling != INDEX_NONE)
+	{
+		DebuggerRows[Row.PrevSibling].NextSibling = First;
+	}
+	else
+	{
+		FirstInList = First;
+	}
+	if (Row.NextSibling != INDEX_NONE)
+	{
+		DebuggerRows[Row.NextSibling].PrevSibling = Last;
+	}
+	else
+	{
+		LastInList = Last;
+	}
+	if (FindDebuggerRow(Row.Node) == RowIndex)
+	{
+		DebuggerRowIndex.Remove(Row.Node);
+	}
+	DebuggerRows.RemoveAt(RowIndex);
+}
+
+ACETeam_Coroutines::FCoroutineExecutor::FDebuggerRowIterator ACETeam_Coroutines::FCoroutineExecutor::CreateDebuggerRowIterator(int32 RootsToSkip) const
+{
+	int32 RowIndex = FirstDebuggerRoot;
+	for (; RootsToSkip > 0 && RowIndex != INDEX_NONE; --RootsToSkip)
+	{
+		RowIndex = DebuggerRows[RowIndex].NextSibling;
+	}
+	return FDebuggerRowIterator(*this, RowIndex);
+}
+
+ACETeam_Coroutines::FCoroutineExecutor::FDebuggerRowIterator& ACETeam_Coroutines::FCoroutineExecutor::FDebuggerRowIterator::operator++()
+{
+	const FDebuggerRow& Row = Exec.DebuggerRows[RowIndex];
+	if (Row.FirstChild != INDEX_NONE)
+	{
+		RowIndex = Row.FirstChild;
+		return *this;
+	}
+	//no children, so continue with the next sibling of the closest ancestor that has one
+	while (RowIndex != INDEX_NONE && Exec.DebuggerRows[RowIndex].NextSibling == INDEX_NONE)
+	{
+		RowIndex = Exec.DebuggerRows[RowIndex].ParentRow;
+	}
+	if (RowIndex != INDEX_NONE)
+	{
+		RowIndex = Exec.DebuggerRows[RowIndex].NextSibling;
+	}
+	return *this;
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::FDebuggerRowIterator::NextRoot()
+{
+	while (Exec.DebuggerRows[RowIndex].ParentRow != INDEX_NONE)
+	{
+		RowIndex = Exec.DebuggerRows[RowIndex].ParentRow;
+	}
+	RowIndex = Exec.DebuggerRows[RowIndex].NextSibling;
+}
+
+void ACETeam_Coroutines::FCoroutineExecutor::TrackNodeStartImpl(FCoroutineNode* Node, FCoroutineNode* Parent, EStatus Status)
+{
 	TRACE_CPUPROFILER_EVENT_SCOPE(FCoroutineExecutor::TrackNodeStart);
-	FDebuggerRow* RowForNode = DebuggerInfo.FindByKey(Node);
-	if (!RowForNode)
+	if (bEmitLifecycleTrace)
+	{
+		FCoroutinesTrace::OutputNodeStart(this, Node, Parent, Node->Debug_GetName(), Status);
+	}
+	if (!bTrackForDebugger)
+		return;
+	int32 RowIndex = FindDebuggerRow(Node);
+	if (RowIndex == INDEX_NONE)
 	{
-		TRACE_CPUPROFILER_EVENT_SCOPE(FCoroutineExecutor::TrackNodeStart);
-		int IndexToInsert = DebuggerInfo.Num();
 		FCoroutineNode* Scope = nullptr;
 		int Depth = 0;
-		if (Parent)
-		{
-			FDebuggerRow* RowForParent = DebuggerInfo.FindByKey(Parent);
-			Depth = RowForParent->Depth + 1;
-			check(RowForParent);
-			RowForParent->bIsLeaf = false;
-			const int IndexForParent = RowForParent - DebuggerInfo.GetData();
-			IndexToInsert = IndexForParent + 1;
-			Scope = RowForParent->bIsScope ? Parent : RowForParent->Scope;
-			if (RowForParent->bIsDeferredNodeGenerator)
+		const int32 ParentRow = Parent ? FindDebuggerRow(Parent) : INDEX_NONE;
+		if (ParentRow != INDEX_NONE)
+		{
+			FDebuggerRow& RowForParent = DebuggerRows[ParentRow];
+			Depth = RowForParent.Depth + 1;
+			RowForParent.bIsLeaf = false;
+			Scope = RowForParent.bIsScope ? Parent : RowForParent.Scope;
+			//nodes generated by the same deferred node replace each other, so they share the row
+			if (RowForParent.bIsDeferredNodeGenerator && RowForParent.FirstChild != INDEX_NONE)
 			{
-				for (int i = IndexToInsert; i < DebuggerInfo.Num(); ++i)
+				RowIndex = RowForParent.FirstChild;
+				FDebuggerRow& ReusedRow = DebuggerRows[RowIndex];
+				if (FindDebuggerRow(ReusedRow.Node) == RowIndex)
 				{
-					if (DebuggerInfo[i].Parent == Parent)
-					{
-						RowForNode = &DebuggerInfo[i];
-						RowForNode->Node = Node;
-						goto RowAssigned;
-					}
+					DebuggerRowIndex.Remove(ReusedRow.Node);
 				}
+				ReusedRow.Node = Node;
+				DebuggerRowIndex.Add(Node, RowIndex);
 			}
 		}
-		RowForNode = &DebuggerInfo.Insert_GetRef(
-			FDebuggerRow{
-				Node, Parent, Scope, Depth, Node->Debug_IsDeferredNodeGenerator(), Parent == nullptr || Node->Debug_IsDebuggerScope(), true
-			}, IndexToInsert);
+		if (RowIndex == INDEX_NONE)
+		{
+			FDebuggerRow NewRow;
+			NewRow.Node = Node;
+			NewRow.Parent = Parent;
+			NewRow.Scope = Scope;
+			NewRow.Depth = Depth;
+			NewRow.bIsDeferredNodeGenerator = Node->Debug_IsDeferredNodeGenerator();
+			NewRow.bIsScope = ParentRow == INDEX_NONE || Node->Debug_IsDebuggerScope();
+			NewRow.bIsLeaf = true;
+			RowIndex = DebuggerRows.Add(MoveTemp(NewRow));
+			DebuggerRowIndex.Add(Node, RowIndex);
+			LinkDebuggerRow(RowIndex, ParentRow);
+		}
 	}
-RowAssigned:
-	if (RowForNode->Entries.Num() > 0)
+	FDebuggerRow& RowForNode = DebuggerRows[RowIndex];
+	if (RowForNode.Entries.Num() > 0)
 	{
 		double CurrentTime = FApp::GetCurrentTime();
-		FDebuggerEntry& LastEntry = RowForNode->Entries.Last();
+		FDebuggerEntry& LastEntry = RowForNode.Entries.Last();
 		//coalesce very short entries, if they happened recently
 		if ((LastEntry.EndTime - LastEntry.StartTime) < 0.03 && (CurrentTime - LastEntry.EndTime) < 0.03)
 		{
@@ -438,39 +776,52 @@ RowAssigned:
 			return;
 		}
 	}
-	RowForNode->Entries.Add(FDebuggerEntry{Node->Debug_GetName(), Status, FApp::GetCurrentTime()});
-#endif
+	RowForNode.Entries.Add(FDebuggerEntry{Node->Debug_GetName(), Status, FApp::GetCurrentTime()});
 }
 
-void ACETeam_Coroutines::FCoroutineExecutor::TrackNodeSuspendFromUpdate(FCoroutineNode* Node)
+void ACETeam_Coroutines::FCoroutineExecutor::TrackNodeSuspendFromUpdateImpl(FCoroutineNode* Node)
 {
-#if WITH_ACETEAM_COROUTINE_DEBUGGER
 	TRACE_CPUPROFILER_EVENT_SCOPE(FCoroutineExecutor::TrackNodeSuspendFromUpdate);
-	FDebuggerRow* RowForNode = DebuggerInfo.FindByKey(Node);
-	if (ensure(RowForNode))
+	if (bEmitLifecycleTrace)
+	{
+		FCoroutinesTrace::OutputNodeSuspend(Node);
+	}
+	if (!bTrackForDebugger)
+		return;
+	//nodes that started before tracking did won't have a row
+	const int32 RowIndex = FindDebuggerRow(Node);
+	if (RowIndex != INDEX_NONE)
 	{
-		if (ensure(RowForNode->Entries.Num() > 0))
+		FDebuggerRow& RowForNode = DebuggerRows[RowIndex];
+		if (ensure(RowForNode.Entries.Num() > 0))
 		{
-			RowForNode->Entries.Last().Status = Suspended;
+			RowForNode.Entries.Last().Status = Suspended;
 		}
 	}
-#endif
 }
 
-void ACETeam_Coroutines::FCoroutineExecutor::TrackNodeEnd(FCoroutineNode* Node, EStatus Status)
+void ACETeam_Coroutines::FCoroutineExecutor::TrackNodeEndImpl(FCoroutineNode* Node, EStatus Status)
 {
-#if WITH_ACETEAM_COROUTINE_DEBUGGER
 	TRACE_CPUPROFILER_EVENT_SCOPE(FCoroutineExecutor::TrackNodeEnd);
-	FDebuggerRow* RowForNode = DebuggerInfo.FindByKey(Node);
-	if (RowForNode)
+	if (bEmitLifecycleTrace)
 	{
-		if (RowForNode->Entries.Num() > 0)
+		FCoroutinesTrace::OutputNodeEnd(Node, Status);
+	}
+	if (!bTrackForDebugger)
+		return;
+	const int32 RowIndex = FindDebuggerRow(Node);
+	if (RowIndex != INDEX_NONE)
+	{
+		FDebuggerRow& RowForNode = DebuggerRows[RowIndex];
+		if (RowForNode.Entries.Num() > 0)
 		{
-			RowForNode->Entries.Last().EndTime = FApp::GetCurrentTime();
+			const double CurrentTime = FApp::GetCurrentTime();
+			RowForNode.Entries.Last().EndTime = CurrentTime;
+			DebuggerExpiryQueue.Add(FDebuggerExpiry{CurrentTime, RowIndex});
 		}
 	}
-#endif
 }
+#endif
 
 ACETeam_Coroutines::FCoroutineExecutor::EFindNodeResult ACETeam_Coroutines::FCoroutineExecutor::FindCoroutineNode(FCoroutineNodeRef const& CoroutinePtr)
 {
@@ -533,4 +884,4 @@ void ACETeam_Coroutines::FCoroutineExecutor::AbortTree( FCoroutineNode* Coroutin
 			}
 		}
 	}
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineExecutorStats.h"
+
+#include "CoreGlobals.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Runtime/Launch/Resources/Version.h"
+#include "Stats/Stats.h"
+#if ENGINE_MAJOR_VERSION >= 5
+#include "ProfilingDebugging/CountersTrace.h"
+#define ACETEAM_COROUTINES_TRACE_COUNTERS COUNTERSTRACE_ENABLED
+#else
+#define ACETEAM_COROUTINES_TRACE_COUNTERS 0
+#endif
+
+DECLARE_STATS_GROUP(TEXT("ACE Coroutines"), STATGROUP_ACETeamCoroutines, STATCAT_Advanced);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nodes Started"), STAT_ACETeamCoroutines_NodesStarted, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nodes Ended"), STAT_ACETeamCoroutines_NodesEnded, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Nodes Aborted"), STAT_ACETeamCoroutines_NodesAborted, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Nodes"), STAT_ACETeamCoroutines_NumActive, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Suspended Nodes"), STAT_ACETeamCoroutines_NumSuspended, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Active Ring Buffer Size"), STAT_ACETeamCoroutines_ActiveCapacity, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Suspended List Size"), STAT_ACETeamCoroutines_SuspendedCapacity, STATGROUP_ACETeamCoroutines);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Reallocations"), STAT_ACETeamCoroutines_Reallocations, STATGROUP_ACETeamCoroutines);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Step Time (ms)"), STAT_ACETeamCoroutines_StepTime, STATGROUP_ACETeamCoroutines);
+
+CSV_DEFINE_CATEGORY(Coroutines, true);
+
+#if ACETEAM_COROUTINES_TRACE_COUNTERS
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_NodesStarted, TEXT("Coroutines/NodesStarted"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_NodesEnded, TEXT("Coroutines/NodesEnded"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_NodesAborted, TEXT("Coroutines/NodesAborted"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_NumActive, TEXT("Coroutines/ActiveNodes"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_NumSuspended, TEXT("Coroutines/SuspendedNodes"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_ActiveCapacity, TEXT("Coroutines/ActiveRingBufferSize"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_SuspendedCapacity, TEXT("Coroutines/SuspendedListSize"));
+TRACE_DECLARE_INT_COUNTER(ACETeamCoroutines_Reallocations, TEXT("Coroutines/Reallocations"));
+TRACE_DECLARE_FLOAT_COUNTER(ACETeamCoroutines_StepTime, TEXT("Coroutines/StepTimeMs"));
+#endif
+
+void ACETeam_Coroutines::Detail::PublishExecutorStepStats(FCoroutineExecutor::FStepStats const& Stats)
+{
+	const float StepTimeMs = static_cast<float>(Stats.StepTimeSeconds * 1000.0);
+
+	//stat counters and accumulating CSV stats are already reset every frame
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_NodesStarted, Stats.NodesStarted);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_NodesEnded, Stats.NodesEnded);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_NodesAborted, Stats.NodesAborted);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_NumActive, Stats.NumActive);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_NumSuspended, Stats.NumSuspended);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_ActiveCapacity, Stats.ActiveCapacity);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_SuspendedCapacity, Stats.SuspendedCapacity);
+	INC_DWORD_STAT_BY(STAT_ACETeamCoroutines_Reallocations, Stats.Reallocations);
+	INC_FLOAT_STAT_BY(STAT_ACETeamCoroutines_StepTime, StepTimeMs);
+
+	CSV_CUSTOM_STAT(Coroutines, NodesStarted, Stats.NodesStarted, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, NodesEnded, Stats.NodesEnded, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, NodesAborted, Stats.NodesAborted, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, ActiveNodes, Stats.NumActive, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, SuspendedNodes, Stats.NumSuspended, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, ActiveRingBufferSize, Stats.ActiveCapacity, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, SuspendedListSize, Stats.SuspendedCapacity, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, Reallocations, Stats.Reallocations, ECsvCustomStatOp::Accumulate);
+	CSV_CUSTOM_STAT(Coroutines, StepTimeMs, StepTimeMs, ECsvCustomStatOp::Accumulate);
+
+#if ACETEAM_COROUTINES_TRACE_COUNTERS
+	//trace counters keep their value, so they're set to the running total of the frame, which is complete after the last executor steps
+	static uint64 TotalsFrame = 0;
+	static FCoroutineExecutor::FStepStats Totals;
+	if (TotalsFrame != GFrameCounter)
+	{
+		TotalsFrame = GFrameCounter;
+		Totals = FCoroutineExecutor::FStepStats();
+	}
+	Totals.NodesStarted += Stats.NodesStarted;
+	Totals.NodesEnded += Stats.NodesEnded;
+	Totals.NodesAborted += Stats.NodesAborted;
+	Totals.NumActive += Stats.NumActive;
+	Totals.NumSuspended += Stats.NumSuspended;
+	Totals.ActiveCapacity += Stats.ActiveCapacity;
+	Totals.SuspendedCapacity += Stats.SuspendedCapacity;
+	Totals.Reallocations += Stats.Reallocations;
+	Totals.StepTimeSeconds += Stats.StepTimeSeconds;
+	TRACE_COUNTER_SET(ACETeamCoroutines_NodesStarted, Totals.NodesStarted);
+	TRACE_COUNTER_SET(ACETeamCoroutines_NodesEnded, Totals.NodesEnded);
+	TRACE_COUNTER_SET(ACETeamCoroutines_NodesAborted, Totals.NodesAborted);
+	TRACE_COUNTER_SET(ACETeamCoroutines_NumActive, Totals.NumActive);
+	TRACE_COUNTER_SET(ACETeamCoroutines_NumSuspended, Totals.NumSuspended);
+	TRACE_COUNTER_SET(ACETeamCoroutines_ActiveCapacity, Totals.ActiveCapacity);
+	TRACE_COUNTER_SET(ACETeamCoroutines_SuspendedCapacity, Totals.SuspendedCapacity);
+	TRACE_COUNTER_SET(ACETeamCoroutines_Reallocations, Totals.Reallocations);
+	TRACE_COUNTER_SET(ACETeamCoroutines_StepTime, Totals.StepTimeSeconds * 1000.0);
+#endif
+}
@@ -0,0 +1,14 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineExecutor.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		//Adds the stats of a step to the totals of the current frame, over all executors.
+		//They show up in "stat ACETeamCoroutines", the "Coroutines" CSV profiler category and the Coroutines/ trace counters
+		void PublishExecutorStepStats(FCoroutineExecutor::FStepStats const& Stats);
+	}
+}
@@ -0,0 +1,160 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineFileIO.h"
+
+#include "Async/Async.h"
+#include "Async/AsyncFileHandle.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		TSharedRef<FAsyncFileRead, ESPMode::ThreadSafe> FAsyncFileRead::Start(FString const& Path, int64 Offset, int64 Size, FOnFinished const& OnFinished)
+		{
+			check(IsInGameThread());
+			TSharedRef<FAsyncFileRead, ESPMode::ThreadSafe> Read = MakeShareable(new FAsyncFileRead(Offset, OnFinished));
+			Read->Begin(Path, Size);
+			return Read;
+		}
+
+		FAsyncFileRead::FAsyncFileRead(int64 InOffset, FOnFinished const& InOnFinished)
+			: Offset(InOffset)
+			, OnFinished(InOnFinished)
+		{
+		}
+
+		FAsyncFileRead::~FAsyncFileRead()
+		{
+			//the read keeps itself alive while a request is in flight, so any request left here has already finished
+			ReleaseRequest(SizeRequest);
+			ReleaseRequest(ReadRequest);
+			delete Handle;
+		}
+
+		void FAsyncFileRead::Begin(FString const& Path, int64 Size)
+		{
+			Handle = FPlatformFileManager::Get().GetPlatformFile().OpenAsyncRead(*Path);
+			if (!Handle || Offset < 0)
+			{
+				Finish(false, FSharedBuffer());
+				return;
+			}
+			if (Size >= 0)
+			{
+				IssueRead(Size);
+				return;
+			}
+			//callbacks run on IO threads, so they leave the rest to the game thread. The read stays alive until then
+			KeepAlive = AsShared();
+			FAsyncFileCallBack Callback = [this](bool bWasCancelled, IAsyncReadRequest* Request)
+			{
+				const int64 FileSize = bWasCancelled ? -1 : Request->GetSizeResults();
+				AsyncTask(ENamedThreads::GameThread, [this, FileSize]
+				{
+					//dropping the last reference destroys the read, so hold it until done
+					const TSharedPtr<FAsyncFileRead, ESPMode::ThreadSafe> Self = MoveTemp(KeepAlive);
+					ReleaseRequest(SizeRequest);
+					OnSizeKnown(FileSize);
+				});
+			};
+			SizeRequest = Handle->SizeRequest(&Callback);
+		}
+
+		void FAsyncFileRead::OnSizeKnown(int64 FileSize)
+		{
+			if (!OnFinished)
+				return;
+			if (FileSize < 0 || Offset > FileSize)
+			{
+				Finish(false, FSharedBuffer());
+				return;
+			}
+			IssueRead(FileSize - Offset);
+		}
+
+		void FAsyncFileRead::IssueRead(int64 BytesToRead)
+		{
+			if (BytesToRead == 0)
+			{
+				Finish(true, FSharedBuffer());
+				return;
+			}
+			KeepAlive = AsShared();
+			FAsyncFileCallBack Callback = [this, BytesToRead](bool bWasCancelled, IAsyncReadRequest* Request)
+			{
+				//taking the results transfers ownership of the memory, which the buffer then frees
+				uint8* Memory = bWasCancelled ? nullptr : Request->GetReadResults();
+				FSharedBuffer Buffer = Memory ? FSharedBuffer::TakeOwnership(Memory, BytesToRead, FMemory::Free) : FSharedBuffer();
+				AsyncTask(ENamedThreads::GameThread, [this, Buffer = MoveTemp(Buffer)]
+				{
+					const TSharedPtr<FAsyncFileRead, ESPMode::ThreadSafe> Self = MoveTemp(KeepAlive);
+					ReleaseRequest(ReadRequest);
+					Finish(!Buffer.IsNull(), Buffer);
+				});
+			};
+			ReadRequest = Handle->ReadRequest(Offset, BytesToRead, AIOP_Normal, &Callback);
+		}
+
+		void FAsyncFileRead::Finish(bool bSucceeded, FSharedBuffer const& Buffer)
+		{
+			//move it out first, the callback is likely to release the last reference to this read
+			FOnFinished Callback = MoveTemp(OnFinished);
+			OnFinished = nullptr;
+			if (Callback)
+			{
+				Callback(bSucceeded, Buffer);
+			}
+		}
+
+		void FAsyncFileRead::ReleaseRequest(IAsyncReadRequest*& Request)
+		{
+			if (Request)
+			{
+				//the callback may still be returning on the IO thread
+				Request->WaitCompletion();
+				delete Request;
+				Request = nullptr;
+			}
+		}
+
+		void FAsyncFileRead::Cancel()
+		{
+			check(IsInGameThread());
+			OnFinished = nullptr;
+			for (IAsyncReadRequest* Request : { SizeRequest, ReadRequest })
+			{
+				if (Request)
+				{
+					Request->Cancel();
+				}
+			}
+		}
+
+		FSharedBuffer MapFileRegion(FString const& Path, int64 Offset, int64 Size)
+		{
+			IMappedFileHandle* MappedHandle = FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*Path);
+			if (!MappedHandle)
+				return FSharedBuffer();
+			const int64 FileSize = MappedHandle->GetFileSize();
+			if (Offset < 0 || Offset >= FileSize)
+			{
+				delete MappedHandle;
+				return FSharedBuffer();
+			}
+			const int64 BytesToMap = Size < 0 ? FileSize - Offset : FMath::Min(Size, FileSize - Offset);
+			IMappedFileRegion* Region = MappedHandle->MapRegion(Offset, BytesToMap);
+			if (!Region)
+			{
+				delete MappedHandle;
+				return FSharedBuffer();
+			}
+			//the region has to be released before the handle it was mapped from
+			return FSharedBuffer::TakeOwnership(Region->GetMappedPtr(), Region->GetMappedSize(), [Region, MappedHandle](void*)
+			{
+				delete Region;
+				delete MappedHandle;
+			});
+		}
+	}
+}
@@ -42,7 +42,7 @@ void ACETeam_Coroutines::Detail::FSoundLoopNode::End(FCoroutineExecutor* Exec, E
 }
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-FString ACETeam_Coroutines::Detail::FSoundLoopNode::Debug_GetName() const
+ACETeam_Coroutines::FCoroutineDebugName ACETeam_Coroutines::Detail::FSoundLoopNode::Debug_GetName() const
 {
 	if (auto AudioComponent = SpawnedComponent.Get())
 	{
@@ -55,7 +55,7 @@ FString ACETeam_Coroutines::Detail::FSoundLoopNode::Debug_GetName() const
 		{
 			return TEXT("SoundLoop");
 		}
-		return FString::Printf(TEXT("SoundLoop: %s"), *SoundBase->GetName());
+		return FCoroutineDebugName(TEXT("SoundLoop: {0}"), SoundBase->GetFName());
 	}
 	return TEXT("SoundLoop");
 }
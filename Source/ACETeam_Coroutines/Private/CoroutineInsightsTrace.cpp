@@ -0,0 +1,168 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineInsightsTrace.h"
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+#if ACETEAM_COROUTINES_TRACE_ENABLED
+
+#include "Trace/Trace.inl"
+
+UE_TRACE_CHANNEL_DEFINE(CoroutinesChannel)
+
+//names are important events, so captures that connect late still get them
+UE_TRACE_EVENT_BEGIN(Coroutines, NodeName, NoSync|Important)
+	UE_TRACE_EVENT_FIELD(uint32, Id)
+	UE_TRACE_EVENT_FIELD(UE::Trace::WideString, Name)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Coroutines, NodeStart, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, ExecutorId)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+	UE_TRACE_EVENT_FIELD(uint64, ParentId)
+	UE_TRACE_EVENT_FIELD(uint32, NameId)
+	UE_TRACE_EVENT_FIELD(uint8, Status)
+	//numeric parameter of the name, which replaces {0} in it
+	UE_TRACE_EVENT_FIELD(uint8, ParamType)
+	UE_TRACE_EVENT_FIELD(float, FloatParam)
+	UE_TRACE_EVENT_FIELD(int32, IntParam)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Coroutines, NodeSuspend, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Coroutines, NodeResume, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Coroutines, NodeEnd, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+	UE_TRACE_EVENT_FIELD(uint8, Status)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Coroutines, WakeUp, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, Cycle)
+	UE_TRACE_EVENT_FIELD(uint64, WakeCycle)
+	UE_TRACE_EVENT_FIELD(uint64, NodeId)
+	UE_TRACE_EVENT_FIELD(uint8, Source)
+	UE_TRACE_EVENT_FIELD(int32, Steps)
+UE_TRACE_EVENT_END()
+
+UE_TRACE_EVENT_BEGIN(Coroutines, ExecutorStep, NoSync)
+	UE_TRACE_EVENT_FIELD(uint64, StartCycle)
+	UE_TRACE_EVENT_FIELD(uint64, EndCycle)
+	UE_TRACE_EVENT_FIELD(uint64, ExecutorId)
+	UE_TRACE_EVENT_FIELD(int32, NumActive)
+	UE_TRACE_EVENT_FIELD(int32, NumSuspended)
+UE_TRACE_EVENT_END()
+
+namespace ACETeam_Coroutines
+{
+	static uint64 TraceId(const void* Ptr)
+	{
+		return static_cast<uint64>(reinterpret_cast<UPTRINT>(Ptr));
+	}
+
+	//only called from the game thread, like the rest of the executor.
+	//Numeric parameters are sent along with each start instead, so values that keep changing don't grow the table
+	static uint32 GetTraceNameId(FCoroutineDebugName const& Name)
+	{
+		if (Name.IsEmpty())
+			return 0;
+		static TMap<FCoroutineDebugName, uint32> NameIds;
+		const bool bHasNumericParam = Name.ParamType == FCoroutineDebugName::EParam::Float || Name.ParamType == FCoroutineDebugName::EParam::Int;
+		const FCoroutineDebugName Key = bHasNumericParam ? FCoroutineDebugName(Name.Pattern) : Name;
+		uint32& Id = NameIds.FindOrAdd(Key);
+		if (Id == 0)
+		{
+			Id = NameIds.Num();
+			//numeric names go out as the bare pattern, so the analyzer can fill in each node's own value
+			const FString NameString = Key.ToString();
+			UE_TRACE_LOG(Coroutines, NodeName, CoroutinesChannel, NameString.Len() * sizeof(TCHAR))
+				<< NodeName.Id(Id)
+				<< NodeName.Name(*NameString, NameString.Len());
+		}
+		return Id;
+	}
+
+	bool FCoroutinesTrace::IsEnabled()
+	{
+		return UE_TRACE_CHANNELEXPR_IS_ENABLED(CoroutinesChannel);
+	}
+
+	void FCoroutinesTrace::OutputNodeStart(const FCoroutineExecutor* Exec, const FCoroutineNode* Node, const FCoroutineNode* Parent, FCoroutineDebugName const& Name, EStatus Status)
+	{
+		const uint32 NameId = GetTraceNameId(Name);
+		UE_TRACE_LOG(Coroutines, NodeStart, CoroutinesChannel)
+			<< NodeStart.Cycle(FPlatformTime::Cycles64())
+			<< NodeStart.ExecutorId(TraceId(Exec))
+			<< NodeStart.NodeId(TraceId(Node))
+			<< NodeStart.ParentId(TraceId(Parent))
+			<< NodeStart.NameId(NameId)
+			<< NodeStart.Status(static_cast<uint8>(Status))
+			<< NodeStart.ParamType(static_cast<uint8>(Name.ParamType))
+			<< NodeStart.FloatParam(Name.ParamType == FCoroutineDebugName::EParam::Float ? Name.FloatParam : 0.0f)
+			<< NodeStart.IntParam(Name.ParamType == FCoroutineDebugName::EParam::Int ? Name.IntParam : 0);
+	}
+
+	void FCoroutinesTrace::OutputNodeSuspend(const FCoroutineNode* Node)
+	{
+		UE_TRACE_LOG(Coroutines, NodeSuspend, CoroutinesChannel)
+			<< NodeSuspend.Cycle(FPlatformTime::Cycles64())
+			<< NodeSuspend.NodeId(TraceId(Node));
+	}
+
+	void FCoroutinesTrace::OutputNodeResume(const FCoroutineNode* Node)
+	{
+		UE_TRACE_LOG(Coroutines, NodeResume, CoroutinesChannel)
+			<< NodeResume.Cycle(FPlatformTime::Cycles64())
+			<< NodeResume.NodeId(TraceId(Node));
+	}
+
+	void FCoroutinesTrace::OutputNodeEnd(const FCoroutineNode* Node, EStatus Status)
+	{
+		UE_TRACE_LOG(Coroutines, NodeEnd, CoroutinesChannel)
+			<< NodeEnd.Cycle(FPlatformTime::Cycles64())
+			<< NodeEnd.NodeId(TraceId(Node))
+			<< NodeEnd.Status(static_cast<uint8>(Status));
+	}
+
+	void FCoroutinesTrace::OutputWakeUp(const FCoroutineNode* Node, EWakeSource Source, uint64 WakeCycle, int32 Steps)
+	{
+		UE_TRACE_LOG(Coroutines, WakeUp, CoroutinesChannel)
+			<< WakeUp.Cycle(FPlatformTime::Cycles64())
+			<< WakeUp.WakeCycle(WakeCycle)
+			<< WakeUp.NodeId(TraceId(Node))
+			<< WakeUp.Source(static_cast<uint8>(Source))
+			<< WakeUp.Steps(Steps);
+	}
+
+	void FCoroutinesTrace::OutputExecutorStep(const FCoroutineExecutor* Exec, uint64 StartCycle, int32 NumActive, int32 NumSuspended)
+	{
+		UE_TRACE_LOG(Coroutines, ExecutorStep, CoroutinesChannel)
+			<< ExecutorStep.StartCycle(StartCycle)
+			<< ExecutorStep.EndCycle(FPlatformTime::Cycles64())
+			<< ExecutorStep.ExecutorId(TraceId(Exec))
+			<< ExecutorStep.NumActive(NumActive)
+			<< ExecutorStep.NumSuspended(NumSuspended);
+	}
+}
+
+#else
+
+namespace ACETeam_Coroutines
+{
+	bool FCoroutinesTrace::IsEnabled() { return false; }
+	void FCoroutinesTrace::OutputNodeStart(const FCoroutineExecutor*, const FCoroutineNode*, const FCoroutineNode*, FCoroutineDebugName const&, EStatus) {}
+	void FCoroutinesTrace::OutputNodeSuspend(const FCoroutineNode*) {}
+	void FCoroutinesTrace::OutputNodeResume(const FCoroutineNode*) {}
+	void FCoroutinesTrace::OutputNodeEnd(const FCoroutineNode*, EStatus) {}
+	void FCoroutinesTrace::OutputWakeUp(const FCoroutineNode*, EWakeSource, uint64, int32) {}
+	void FCoroutinesTrace::OutputExecutorStep(const FCoroutineExecutor*, uint64, int32, int32) {}
+}
+
+#endif
+#endif // WITH_ACETEAM_COROUTINE_DEBUGGER
@@ -0,0 +1,34 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineExecutor.h"
+#include "Trace/Config.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER && UE_TRACE_ENABLED && ENGINE_MAJOR_VERSION >= 5
+#define ACETEAM_COROUTINES_TRACE_ENABLED 1
+#else
+#define ACETEAM_COROUTINES_TRACE_ENABLED 0
+#endif
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+namespace ACETeam_Coroutines
+{
+	/**
+	 * Records the lifecycle of coroutine nodes in the "Coroutines" trace channel, so captures can be analyzed offline
+	 * (see the ACETeam_CoroutinesInsights module). Nodes and executors are identified by address, and names are sent once
+	 * per distinct debug name.
+	 */
+	struct FCoroutinesTrace
+	{
+		static bool IsEnabled();
+		static void OutputNodeStart(const FCoroutineExecutor* Exec, const FCoroutineNode* Node, const FCoroutineNode* Parent, FCoroutineDebugName const& Name, EStatus Status);
+		static void OutputNodeSuspend(const FCoroutineNode* Node);
+		static void OutputNodeResume(const FCoroutineNode* Node);
+		static void OutputNodeEnd(const FCoroutineNode* Node, EStatus Status);
+		//A branch resumed after being woken up from outside the executor, at WakeCycle
+		static void OutputWakeUp(const FCoroutineNode* Node, EWakeSource Source, uint64 WakeCycle, int32 Steps);
+		static void OutputExecutorStep(const FCoroutineExecutor* Exec, uint64 StartCycle, int32 NumActive, int32 NumSuspended);
+	};
+}
+#endif // WITH_ACETEAM_COROUTINE_DEBUGGER
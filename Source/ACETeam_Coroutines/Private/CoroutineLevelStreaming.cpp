@@ -0,0 +1,178 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineLevelStreaming.h"
+
+#include "CoroutineExecutor.h"
+#include "CoroutineLog.h"
+#include "Engine/LevelStreaming.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#if ACETEAM_HAS_LEVEL_STREAMING_DELEGATES
+#include "Streaming/LevelStreamingDelegates.h"
+#endif
+
+int32 GMaxLevelVisibilityTransitions = 1;
+FAutoConsoleVariableRef MaxLevelVisibilityTransitionsCVar (TEXT("ace.LevelStreaming.MaxVisibilityTransitions"), GMaxLevelVisibilityTransitions,
+	TEXT("How many levels streamed with _StreamLevel can be made visible or hidden at the same time"),
+	FConsoleVariableDelegate::CreateLambda([](IConsoleVariable*)
+	{
+		ACETeam_Coroutines::GetLevelVisibilityBudget()->SetMaxActive(FMath::Max(GMaxLevelVisibilityTransitions, 1));
+	}));
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		bool FLevelStreamingNode::NeedsVisibilityChange(ULevelStreaming const* Level, ELevelStreamingTarget Target)
+		{
+			if (!Level)
+				return false;
+			return Level->IsLevelVisible() != (Target == ELevelStreamingTarget::Visible);
+		}
+
+		bool FLevelStreamingNode::HasReachedTarget(ULevelStreaming const* StreamingLevel) const
+		{
+			if (Phase == EPhase::Load)
+			{
+				return StreamingLevel->IsLevelLoaded();
+			}
+			switch (Target)
+			{
+			case ELevelStreamingTarget::Unloaded:
+				return !StreamingLevel->IsLevelLoaded();
+			case ELevelStreamingTarget::LoadedHidden:
+				return StreamingLevel->IsLevelLoaded() && !StreamingLevel->IsLevelVisible();
+			case ELevelStreamingTarget::Visible:
+				return StreamingLevel->IsLevelVisible();
+			}
+			return false;
+		}
+
+		EStatus FLevelStreamingNode::Start(FCoroutineExecutor* Exec)
+		{
+			ULevelStreaming* StreamingLevel = LevelGetter();
+			Level = StreamingLevel;
+			if (!StreamingLevel)
+			{
+				UE_LOG(LogACETeamCoroutines, Warning, TEXT("_StreamLevel couldn't find the streaming level"));
+				return Failed;
+			}
+			if (Phase == EPhase::Load)
+			{
+				StreamingLevel->SetShouldBeLoaded(true);
+			}
+			else
+			{
+				StreamingLevel->SetShouldBeLoaded(Target != ELevelStreamingTarget::Unloaded);
+				StreamingLevel->SetShouldBeVisible(Target == ELevelStreamingTarget::Visible);
+			}
+			if (HasReachedTarget(StreamingLevel))
+			{
+				return Completed;
+			}
+			CachedExec = Exec;
+#if ACETEAM_HAS_LEVEL_STREAMING_DELEGATES
+			StateChangedHandle = FLevelStreamingDelegates::OnLevelStreamingStateChanged.AddSP(AsShared(), &FLevelStreamingNode::OnLevelStreamingStateChanged);
+			return Suspended;
+#else
+			return Running;
+#endif
+		}
+
+		EStatus FLevelStreamingNode::Update(FCoroutineExecutor* Exec, float dt)
+		{
+			ULevelStreaming* StreamingLevel = Level.Get();
+			if (!StreamingLevel)
+				return Failed;
+			return HasReachedTarget(StreamingLevel) ? Completed : Running;
+		}
+
+#if ACETEAM_HAS_LEVEL_STREAMING_DELEGATES
+		void FLevelStreamingNode::OnLevelStreamingStateChanged(UWorld* World, ULevelStreaming const* StreamingLevel, ULevel* LevelIfLoaded, ELevelStreamingState PreviousState, ELevelStreamingState NewState)
+		{
+			if (!CachedExec || StreamingLevel != Level.Get())
+				return;
+			if (NewState == ELevelStreamingState::FailedToLoad || NewState == ELevelStreamingState::Removed)
+			{
+				CachedExec->ForceNodeEnd(this, Failed, EWakeSource::Streaming);
+			}
+			//visibility flags are only final once the transition itself is done
+			else if (NewState != ELevelStreamingState::MakingVisible && NewState != ELevelStreamingState::MakingInvisible && HasReachedTarget(StreamingLevel))
+			{
+				CachedExec->ForceNodeEnd(this, Completed, EWakeSource::Streaming);
+			}
+		}
+#endif
+
+		void FLevelStreamingNode::StopListening()
+		{
+#if ACETEAM_HAS_LEVEL_STREAMING_DELEGATES
+			if (StateChangedHandle.IsValid())
+			{
+				FLevelStreamingDelegates::OnLevelStreamingStateChanged.Remove(StateChangedHandle);
+				StateChangedHandle.Reset();
+			}
+#endif
+		}
+
+		void FLevelStreamingNode::End(FCoroutineExecutor* Exec, EStatus Status)
+		{
+			StopListening();
+			CachedExec = nullptr;
+		}
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		FCoroutineDebugName FLevelStreamingNode::Debug_GetName() const
+		{
+			static const TCHAR* TargetPatterns[] = { TEXT("StreamLevel {0} -> Unloaded"), TEXT("StreamLevel {0} -> LoadedHidden"), TEXT("StreamLevel {0} -> Visible") };
+			const ULevelStreaming* StreamingLevel = Level.Get();
+			return FCoroutineDebugName(Phase == EPhase::Load ? TEXT("StreamLevel {0} -> Loaded") : TargetPatterns[static_cast<uint8>(Target)],
+				StreamingLevel ? StreamingLevel->GetWorldAssetPackageFName() : NAME_None);
+		}
+#endif
+
+		FCoroutineNodeRef MakeLevelStreamingSequence(TFunction<ULevelStreaming* ()> const& LevelGetter, ELevelStreamingTarget Target)
+		{
+			auto ApplyTarget = [LevelGetter, Target]() -> FCoroutineNodeRef
+			{
+				auto TargetNode = MakeShared<FLevelStreamingNode, DefaultSPMode>(LevelGetter, Target, FLevelStreamingNode::EPhase::Target);
+				//only take a slot from the budget when the level is actually going to be added to or removed from the world
+				if (FLevelStreamingNode::NeedsVisibilityChange(LevelGetter(), Target))
+				{
+					return _SemaphoreScope(GetLevelVisibilityBudget())(TargetNode);
+				}
+				return TargetNode;
+			};
+			if (Target == ELevelStreamingTarget::Unloaded)
+			{
+				return _ConvertLambda(ApplyTarget);
+			}
+			//load outside of the budget, since it doesn't touch the world until the level is made visible
+			return _Seq(
+				MakeShared<FLevelStreamingNode, DefaultSPMode>(LevelGetter, Target, FLevelStreamingNode::EPhase::Load),
+				ApplyTarget
+			);
+		}
+	}
+
+	FSemaphoreRef GetLevelVisibilityBudget()
+	{
+		static FSemaphoreRef Budget = MakeSemaphore(FMath::Max(GMaxLevelVisibilityTransitions, 1));
+		return Budget;
+	}
+
+	FCoroutineNodeRef _StreamLevel(ULevelStreaming* Level, ELevelStreamingTarget Target)
+	{
+		TWeakObjectPtr<ULevelStreaming> WeakLevel = Level;
+		return Detail::MakeLevelStreamingSequence([WeakLevel] { return WeakLevel.Get(); }, Target);
+	}
+
+	FCoroutineNodeRef _StreamLevel(UObject* WorldContextObject, FName LevelPackageName, ELevelStreamingTarget Target)
+	{
+		TWeakObjectPtr<UObject> WeakContext = WorldContextObject;
+		return Detail::MakeLevelStreamingSequence([WeakContext, LevelPackageName]() -> ULevelStreaming*
+		{
+			UObject* Context = WeakContext.Get();
+			return Context ? UGameplayStatics::GetStreamingLevel(Context, LevelPackageName) : nullptr;
+		}, Target);
+	}
+}
@@ -0,0 +1,188 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineLocks.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		EStatus FReadWriteLockHandlerNode::Start(FCoroutineExecutor* Exec)
+		{
+			if (Lock->TryTake(AsShared()))
+			{
+				bHoldsLock = true;
+				return FCoroutineDecorator::Start(Exec);
+			}
+			CachedExec = Exec;
+			return Suspended;
+		}
+
+		EStatus FReadWriteLockHandlerNode::OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child)
+		{
+			bHoldsLock = false;
+			Lock->Release(bWriter);
+			return Status;
+		}
+
+		void FReadWriteLockHandlerNode::End(FCoroutineExecutor* Exec, EStatus Status)
+		{
+			FCoroutineDecorator::End(Exec, Status);
+			if (bHoldsLock)
+			{
+				bHoldsLock = false;
+				Lock->Release(bWriter);
+			}
+			else if (CachedExec)
+			{
+				ensure(Lock->DropFromQueue(AsShared()));
+			}
+			CachedExec = nullptr;
+		}
+
+		void FReadWriteLockHandlerNode::Resume()
+		{
+			check(CachedExec);
+			bHoldsLock = true;
+			CachedExec->EnqueueCoroutineNode(m_Child.ToSharedRef(), this, EWakeSource::Lock);
+			CachedExec = nullptr;
+		}
+
+		bool FReadWriteLock::CanTake(bool bWriter) const
+		{
+			if (bWriter)
+			{
+				return !bWriterActive && ActiveReaders == 0;
+			}
+			return !bWriterActive;
+		}
+
+		bool FReadWriteLock::TryTake(FReadWriteLockHandlerRef const& Handler)
+		{
+			//anyone already waiting goes first, so readers don't overtake a queued writer
+			if (QueuedHandlers.Num() == 0 && CanTake(Handler->IsWriter()))
+			{
+				if (Handler->IsWriter())
+				{
+					bWriterActive = true;
+				}
+				else
+				{
+					++ActiveReaders;
+				}
+				return true;
+			}
+			QueuedHandlers.Add(Handler);
+			return false;
+		}
+
+		bool FReadWriteLock::DropFromQueue(FReadWriteLockHandlerRef const& Handler)
+		{
+			const bool bRemoved = QueuedHandlers.Remove(Handler) > 0;
+			//dropping a writer from the front of the queue may unblock the readers behind it
+			ResumeQueued();
+			return bRemoved;
+		}
+
+		void FReadWriteLock::Release(bool bWriter)
+		{
+			if (bWriter)
+			{
+				check(bWriterActive);
+				bWriterActive = false;
+			}
+			else
+			{
+				check(ActiveReaders > 0);
+				--ActiveReaders;
+			}
+			ResumeQueued();
+		}
+
+		void FReadWriteLock::ResumeQueued()
+		{
+			int NumToStart = 0;
+			for (; NumToStart < QueuedHandlers.Num(); ++NumToStart)
+			{
+				const bool bWriter = QueuedHandlers[NumToStart]->IsWriter();
+				if (!CanTake(bWriter))
+				{
+					break;
+				}
+				if (bWriter)
+				{
+					bWriterActive = true;
+					++NumToStart;
+					break;
+				}
+				++ActiveReaders;
+			}
+			if (NumToStart == 0)
+			{
+				return;
+			}
+			decltype(QueuedHandlers) ToStart;
+			ToStart.Reserve(NumToStart);
+			for (int i = 0; i < NumToStart; ++i)
+			{
+				ToStart.Emplace(MoveTemp(QueuedHandlers[i]));
+			}
+			QueuedHandlers.RemoveAt(0, NumToStart);
+			for (auto const& StartingHandler : ToStart)
+			{
+				StartingHandler->Resume();
+			}
+		}
+
+		void FKeyedLockHandlerNode::Resume()
+		{
+			check(CachedExec);
+			bHoldsLock = true;
+			CachedExec->EnqueueCoroutineNode(m_Child.ToSharedRef(), this, EWakeSource::Lock);
+			CachedExec = nullptr;
+		}
+
+		int32 FLockTableBase::AllocateSlot()
+		{
+			return Slots.Add(FLockSlot());
+		}
+
+		void FLockTableBase::EnqueueAt(int32 SlotIndex, FKeyedLockHandlerRef const& Handler)
+		{
+			Slots[SlotIndex].QueuedHandlers.Add(Handler);
+		}
+
+		bool FLockTableBase::DropFromSlot(int32 SlotIndex, FKeyedLockHandlerRef const& Handler)
+		{
+			//the slot is still held by someone else, so it can't become free here
+			return Slots[SlotIndex].QueuedHandlers.Remove(Handler) > 0;
+		}
+
+		bool FLockTableBase::ReleaseSlot(int32 SlotIndex)
+		{
+			auto& QueuedHandlers = Slots[SlotIndex].QueuedHandlers;
+			if (QueuedHandlers.Num())
+			{
+				const FKeyedLockHandlerRef Current = QueuedHandlers[0];
+				QueuedHandlers.RemoveAt(0);
+				Current->Resume();
+				return false;
+			}
+			Slots.RemoveAt(SlotIndex);
+			return true;
+		}
+	}
+
+	Detail::FReadWriteLockHelper _ReadScope(FReadWriteLockRef const& Lock)
+	{
+		return Detail::FReadWriteLockHelper(Lock, false);
+	}
+
+	Detail::FReadWriteLockHelper _WriteScope(FReadWriteLockRef const& Lock)
+	{
+		return Detail::FReadWriteLockHelper(Lock, true);
+	}
+
+	FReadWriteLockRef MakeReadWriteLock()
+	{
+		return MakeShared<Detail::FReadWriteLock>();
+	}
+}
@@ -0,0 +1,43 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineNavigation.h"
+
+#include "CoroutineLog.h"
+#include "NavigationData.h"
+#include "NavigationSystem.h"
+#include "NavFilters/NavigationQueryFilter.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		uint32 RequestAsyncPathfind(UObject* Querier, FVector const& Start, FVector const& End, FFindPathSettings const& Settings, FOnAsyncPathFound const& OnPathFound)
+		{
+			UNavigationSystemV1* NavSys = Querier ? FNavigationSystem::GetCurrent<UNavigationSystemV1>(Querier->GetWorld()) : nullptr;
+			if (!NavSys)
+			{
+				UE_LOG(LogACETeamCoroutines, Warning, TEXT("_FindPathAsync needs a querier in a world with a navigation system"));
+				return 0;
+			}
+			const ANavigationData* NavData = NavSys->GetNavDataForProps(Settings.AgentProperties, Start);
+			if (!NavData)
+				return 0;
+			FPathFindingQuery Query(Querier, *NavData, Start, End, UNavigationQueryFilter::GetQueryFilter(*NavData, Querier, Settings.FilterClass));
+			Query.SetAllowPartialPaths(Settings.bAllowPartialPath);
+			return NavSys->FindPathAsync(Settings.AgentProperties, Query, FNavPathQueryDelegate::CreateLambda(
+				[OnPathFound](uint32, ENavigationQueryResult::Type Result, FNavPathSharedPtr Path)
+				{
+					OnPathFound.ExecuteIfBound(Result == ENavigationQueryResult::Success && Path.IsValid() && Path->IsValid(), Path);
+				}));
+		}
+
+		void AbortAsyncPathfind(UObject* Querier, uint32 QueryID)
+		{
+			if (QueryID == 0 || !Querier)
+				return;
+			if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(Querier->GetWorld()))
+			{
+				NavSys->AbortAsyncFindPathRequest(QueryID);
+			}
+		}
+	}
+}
@@ -0,0 +1,164 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineRateLimit.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		EStatus FRateLimitHandlerNode::Start(FCoroutineExecutor* Exec)
+		{
+			if (RateLimiter->TryTake(AsShared()))
+			{
+				return FCoroutineDecorator::Start(Exec);
+			}
+			CachedExec = Exec;
+			return Suspended;
+		}
+
+		void FRateLimitHandlerNode::End(FCoroutineExecutor* Exec, EStatus Status)
+		{
+			FCoroutineDecorator::End(Exec, Status);
+			//tokens are consumed on entry, so there's nothing to give back unless we were still waiting
+			if (CachedExec)
+			{
+				ensure(RateLimiter->DropFromQueue(AsShared()));
+			}
+			CachedExec = nullptr;
+		}
+
+		void FRateLimitHandlerNode::Resume()
+		{
+			check(CachedExec);
+			CachedExec->EnqueueCoroutineNode(m_Child.ToSharedRef(), this, EWakeSource::RateLimit);
+			CachedExec = nullptr;
+		}
+
+		FRateLimiter::FRateLimiter(float InTokensPerSecond, int InBurstSize)
+			: TokensPerSecond(InTokensPerSecond)
+			, BurstSize(InBurstSize)
+			, Tokens(InBurstSize)
+			, LastRefillTime(FPlatformTime::Seconds())
+		{
+			check(TokensPerSecond > 0.0f && BurstSize > 0);
+		}
+
+		FRateLimiter::~FRateLimiter()
+		{
+			ClearWakeUp();
+		}
+
+		bool FRateLimiter::IsAvailable() const
+		{
+			const double Elapsed = FPlatformTime::Seconds() - LastRefillTime;
+			return QueuedHandlers.Num() == 0 && Tokens + Elapsed * TokensPerSecond >= 1.0;
+		}
+
+		bool FRateLimiter::TryTake(FRateLimitHandlerRef const& Handler)
+		{
+			Refill();
+			//don't let new arrivals jump ahead of branches that are already waiting
+			if (QueuedHandlers.Num() == 0 && Tokens >= 1.0)
+			{
+				Tokens -= 1.0;
+				return true;
+			}
+			QueuedHandlers.Add(Handler);
+			ScheduleWakeUp();
+			return false;
+		}
+
+		bool FRateLimiter::DropFromQueue(FRateLimitHandlerRef const& Handler)
+		{
+			const bool bRemoved = QueuedHandlers.Remove(Handler) > 0;
+			if (QueuedHandlers.Num() == 0)
+			{
+				ClearWakeUp();
+			}
+			return bRemoved;
+		}
+
+		void FRateLimiter::SetRate(float NewTokensPerSecond, int NewBurstSize)
+		{
+			check(NewTokensPerSecond > 0.0f && NewBurstSize > 0);
+			Refill();
+			TokensPerSecond = NewTokensPerSecond;
+			BurstSize = NewBurstSize;
+			Tokens = FMath::Min(Tokens, static_cast<double>(BurstSize));
+			if (QueuedHandlers.Num() > 0)
+			{
+				//the time until the next token changed, so the pending wake up is no longer accurate
+				ClearWakeUp();
+				ResumeQueued();
+			}
+		}
+
+		void FRateLimiter::Refill()
+		{
+			const double CurrentTime = FPlatformTime::Seconds();
+			Tokens = FMath::Min(static_cast<double>(BurstSize), Tokens + (CurrentTime - LastRefillTime) * TokensPerSecond);
+			LastRefillTime = CurrentTime;
+		}
+
+		void FRateLimiter::ResumeQueued()
+		{
+			Refill();
+			while (QueuedHandlers.Num() > 0 && Tokens >= 1.0)
+			{
+				Tokens -= 1.0;
+				const FRateLimitHandlerRef Current = QueuedHandlers[0];
+				QueuedHandlers.RemoveAt(0);
+				Current->Resume();
+			}
+			if (QueuedHandlers.Num() > 0)
+			{
+				ScheduleWakeUp();
+			}
+		}
+
+		void FRateLimiter::ScheduleWakeUp()
+		{
+			if (WakeUpHandle.IsValid())
+			{
+				return;
+			}
+			const float Delay = static_cast<float>((1.0 - Tokens) / TokensPerSecond);
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+			WakeUpHandle = FTSTicker::GetCoreTicker()
+#else
+			WakeUpHandle = FTicker::GetCoreTicker()
+#endif
+			.AddTicker(FTickerDelegate::CreateLambda([WeakThis = AsWeak()](float)
+			{
+				if (auto This = WeakThis.Pin())
+				{
+					This->WakeUpHandle.Reset();
+					This->ResumeQueued();
+				}
+				return false;
+			}), FMath::Max(Delay, 0.0f));
+		}
+
+		void FRateLimiter::ClearWakeUp()
+		{
+			if (WakeUpHandle.IsValid())
+			{
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+				FTSTicker::GetCoreTicker().RemoveTicker(WakeUpHandle);
+#else
+				FTicker::GetCoreTicker().RemoveTicker(WakeUpHandle);
+#endif
+				WakeUpHandle.Reset();
+			}
+		}
+	}
+
+	Detail::FRateLimitHelper _RateLimit(FRateLimiterRef const& RateLimiter)
+	{
+		return Detail::FRateLimitHelper(RateLimiter);
+	}
+
+	FRateLimiterRef MakeRateLimiter(float TokensPerSecond, int BurstSize)
+	{
+		return MakeShared<Detail::FRateLimiter>(TokensPerSecond, BurstSize);
+	}
+}
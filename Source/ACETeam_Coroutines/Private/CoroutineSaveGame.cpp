@@ -0,0 +1,47 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineSaveGame.h"
+
+#include "GameFramework/SaveGame.h"
+#include "Kismet/GameplayStatics.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		void RequestAsyncLoadGame(FString const& SlotName, int32 UserIndex, FOnAsyncSaveGameLoaded const& OnLoaded)
+		{
+			UGameplayStatics::AsyncLoadGameFromSlot(SlotName, UserIndex, FAsyncLoadGameFromSlotDelegate::CreateLambda(
+				[OnLoaded](FString const&, const int32, USaveGame* SaveGame)
+				{
+					OnLoaded.ExecuteIfBound(SaveGame);
+				}));
+		}
+
+		bool FSaveGameAsyncNode::StartRequest()
+		{
+			USaveGame* SaveGame = SaveGameGetter();
+			if (!SaveGame)
+				return false;
+			//there's no way to cancel the save, so a result arriving after the node ended is ignored
+			UGameplayStatics::AsyncSaveGameToSlot(SaveGame, SlotName, UserIndex,
+				FAsyncSaveGameToSlotDelegate::CreateSP(AsShared(), &FSaveGameAsyncNode::OnSaved));
+			return true;
+		}
+
+		void FSaveGameAsyncNode::OnSaved(FString const& Slot, int32 User, bool bSucceeded)
+		{
+			DeliverResult(bSucceeded);
+		}
+	}
+
+	FCoroutineNodeRef _SaveGameAsync(USaveGame* SaveGame, FString const& SlotName, int32 UserIndex)
+	{
+		TWeakObjectPtr<USaveGame> WeakSaveGame = SaveGame;
+		return _SaveGameAsync([WeakSaveGame] { return WeakSaveGame.Get(); }, SlotName, UserIndex);
+	}
+
+	FCoroutineNodeRef _SaveGameAsync(TFunction<USaveGame* ()> const& SaveGameGetter, FString const& SlotName, int32 UserIndex)
+	{
+		return MakeShared<Detail::FSaveGameAsyncNode, DefaultSPMode>(SaveGameGetter, SlotName, UserIndex);
+	}
+}
@@ -0,0 +1,178 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineScopeCost.h"
+#include "CoroutineScopeCostInternal.h"
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+#include "CoroutineLog.h"
+#include "CoreGlobals.h"
+#include "HAL/IConsoleManager.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		struct FScopeCost
+		{
+			FName Name;
+			uint64 InclusiveCycles = 0;
+			uint64 ExclusiveCycles = 0;
+			uint64 NumEvaluations = 0;
+			uint64 Frame = 0;
+			uint64 FrameCycles = 0;
+			uint64 PeakFrameCycles = 0;
+			uint64 BudgetCycles = 0;
+			int32 NumFrames = 0;
+			int32 NumOverruns = 0;
+			bool bOverranThisFrame = false;
+		};
+
+		static TArray<FScopeCost> GScopeCosts;
+		static TMap<FName, int32> GScopeCostIndex;
+		//Kept apart from the costs, so budgets can be set before their scopes ever run
+		static TMap<FName, float> GScopeBudgets;
+
+		static int32 GScopeCostEnabled = 0;
+		static FAutoConsoleVariableRef ScopeCostCVar (TEXT("ace.Coroutines.ScopeCost"), GScopeCostEnabled, TEXT("If set, the CPU time spent in each named coroutine scope is accumulated for ace.Coroutines.ScopeCostReport. It's also accumulated while any scope has a budget"));
+
+		static uint64 BudgetMsToCycles(float BudgetMs)
+		{
+			return BudgetMs > 0.0f ? static_cast<uint64>(BudgetMs / (1000.0 * FPlatformTime::GetSecondsPerCycle64())) : 0;
+		}
+
+		static double CyclesToMs(uint64 Cycles)
+		{
+			return FPlatformTime::ToMilliseconds64(Cycles);
+		}
+
+		static void ScopeCostReport(const TArray<FString>& Args)
+		{
+			const int32 Count = Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 10;
+			TArray<const FScopeCost*> Sorted;
+			for (const FScopeCost& Cost : GScopeCosts)
+			{
+				if (Cost.NumEvaluations > 0 || Cost.InclusiveCycles > 0)
+				{
+					Sorted.Add(&Cost);
+				}
+			}
+			Sorted.Sort([](const FScopeCost& A, const FScopeCost& B) { return A.InclusiveCycles > B.InclusiveCycles; });
+			UE_LOG(LogACETeamCoroutines, Display, TEXT("Top %d coroutine scopes by inclusive time:"), FMath::Min(Count, Sorted.Num()));
+			UE_LOG(LogACETeamCoroutines, Display, TEXT("%-40s %12s %12s %10s %8s %12s %12s %10s %8s"),
+				TEXT("Scope"), TEXT("Incl (ms)"), TEXT("Excl (ms)"), TEXT("Evals"), TEXT("Frames"), TEXT("Avg/Frame"), TEXT("Peak/Frame"), TEXT("Budget"), TEXT("Overruns"));
+			for (int32 i = 0; i < Sorted.Num() && i < Count; ++i)
+			{
+				const FScopeCost& Cost = *Sorted[i];
+				UE_LOG(LogACETeamCoroutines, Display, TEXT("%-40s %12.3f %12.3f %10llu %8d %12.3f %12.3f %10.2f %8d"),
+					*Cost.Name.ToString(), CyclesToMs(Cost.InclusiveCycles), CyclesToMs(Cost.ExclusiveCycles), Cost.NumEvaluations, Cost.NumFrames,
+					Cost.NumFrames > 0 ? CyclesToMs(Cost.InclusiveCycles) / Cost.NumFrames : 0.0, CyclesToMs(Cost.PeakFrameCycles),
+					GScopeBudgets.FindRef(Cost.Name), Cost.NumOverruns);
+			}
+		}
+
+		static void ScopeCostReset()
+		{
+			//entries are kept, since scope nodes refer to them by index
+			for (FScopeCost& Cost : GScopeCosts)
+			{
+				const FName Name = Cost.Name;
+				const uint64 BudgetCycles = Cost.BudgetCycles;
+				Cost = FScopeCost();
+				Cost.Name = Name;
+				Cost.BudgetCycles = BudgetCycles;
+			}
+		}
+
+		static void SetScopeBudgetCommand(const TArray<FString>& Args)
+		{
+			if (Args.Num() < 2)
+			{
+				UE_LOG(LogACETeamCoroutines, Display, TEXT("Usage: ace.Coroutines.ScopeBudget <ScopeName> <BudgetMs>"));
+				return;
+			}
+			SetScopeBudget(FName(*Args[0]), FCString::Atof(*Args[1]));
+		}
+
+		static FAutoConsoleCommand ScopeCostReportCmd(
+			TEXT("ace.Coroutines.ScopeCostReport"),
+			TEXT("Logs the named coroutine scopes that took the most CPU time since accounting started or was reset. Usage: ace.Coroutines.ScopeCostReport [Count]"),
+			FConsoleCommandWithArgsDelegate::CreateStatic(&ScopeCostReport));
+
+		static FAutoConsoleCommand ScopeCostResetCmd(
+			TEXT("ace.Coroutines.ScopeCostReset"),
+			TEXT("Clears the CPU time accumulated for named coroutine scopes"),
+			FConsoleCommandDelegate::CreateStatic(&ScopeCostReset));
+
+		static FAutoConsoleCommand ScopeBudgetCmd(
+			TEXT("ace.Coroutines.ScopeBudget"),
+			TEXT("Sets the CPU budget per frame of the named coroutine scopes with this name. Zero removes it. Usage: ace.Coroutines.ScopeBudget <ScopeName> <BudgetMs>"),
+			FConsoleCommandWithArgsDelegate::CreateStatic(&SetScopeBudgetCommand));
+	}
+}
+
+void ACETeam_Coroutines::SetScopeBudget(FName ScopeName, float BudgetMs)
+{
+	using namespace Detail;
+	if (BudgetMs > 0.0f)
+	{
+		GScopeBudgets.Add(ScopeName, BudgetMs);
+	}
+	else
+	{
+		GScopeBudgets.Remove(ScopeName);
+	}
+	if (const int32* Index = GScopeCostIndex.Find(ScopeName))
+	{
+		GScopeCosts[*Index].BudgetCycles = BudgetMsToCycles(BudgetMs);
+	}
+}
+
+bool ACETeam_Coroutines::Detail::IsScopeCostEnabled()
+{
+	return GScopeCostEnabled != 0 || GScopeBudgets.Num() > 0;
+}
+
+int32 ACETeam_Coroutines::Detail::FindOrAddScopeCost(FName ScopeName)
+{
+	if (const int32* Index = GScopeCostIndex.Find(ScopeName))
+		return *Index;
+	const int32 Index = GScopeCosts.AddDefaulted();
+	GScopeCosts[Index].Name = ScopeName;
+	GScopeCosts[Index].BudgetCycles = BudgetMsToCycles(GScopeBudgets.FindRef(ScopeName));
+	GScopeCostIndex.Add(ScopeName, Index);
+	return Index;
+}
+
+bool ACETeam_Coroutines::Detail::AddScopeCost(int32 Index, uint64 Cycles, bool bExclusive)
+{
+	FScopeCost& Cost = GScopeCosts[Index];
+	if (Cost.Frame != GFrameCounter)
+	{
+		Cost.Frame = GFrameCounter;
+		Cost.FrameCycles = 0;
+		Cost.bOverranThisFrame = false;
+		++Cost.NumFrames;
+	}
+	if (bExclusive)
+	{
+		Cost.ExclusiveCycles += Cycles;
+		++Cost.NumEvaluations;
+	}
+	Cost.InclusiveCycles += Cycles;
+	Cost.FrameCycles += Cycles;
+	Cost.PeakFrameCycles = FMath::Max(Cost.PeakFrameCycles, Cost.FrameCycles);
+	if (Cost.BudgetCycles != 0 && !Cost.bOverranThisFrame && Cost.FrameCycles > Cost.BudgetCycles)
+	{
+		Cost.bOverranThisFrame = true;
+		++Cost.NumOverruns;
+		return true;
+	}
+	return false;
+}
+
+void ACETeam_Coroutines::Detail::LogScopeOverrun(int32 Index, FString const& NodeName)
+{
+	const FScopeCost& Cost = GScopeCosts[Index];
+	UE_LOG(LogACETeamCoroutines, Warning, TEXT("Coroutine scope %s went over its budget of %.2fms this frame (%.2fms) while running %s"),
+		*Cost.Name.ToString(), CyclesToMs(Cost.BudgetCycles), CyclesToMs(Cost.FrameCycles), *NodeName);
+}
+#endif
@@ -0,0 +1,22 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+//the public header with the same name, on the module's public include path
+#include "CoroutineScopeCost.h"
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		//Accounting runs while ace.Coroutines.ScopeCost is set, or while any scope has a budget
+		bool IsScopeCostEnabled();
+		//Scopes with the same name share their costs. Indices stay valid for the whole run, so scope nodes can cache them
+		int32 FindOrAddScopeCost(FName ScopeName);
+		//Exclusive time is only added to the innermost scope of the node that ran, inclusive time to it and the scopes around it.
+		//Returns true the first time in the current frame that the scope goes over its budget
+		bool AddScopeCost(int32 Index, uint64 Cycles, bool bExclusive);
+		void LogScopeOverrun(int32 Index, FString const& NodeName);
+	}
+}
+#endif
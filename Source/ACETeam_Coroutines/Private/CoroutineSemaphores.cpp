@@ -40,18 +40,20 @@ namespace ACETeam_Coroutines
 		void FSemaphoreHandlerNode::Resume()
 		{
 			check(CachedExec);
-			CachedExec->EnqueueCoroutineNode(m_Child.ToSharedRef(), this);
+			CachedExec->EnqueueCoroutineNode(m_Child.ToSharedRef(), this, EWakeSource::Semaphore);
 			CachedExec = nullptr;
 		}
 
 		bool FSemaphore::TryTake(FSemaphoreHandlerRef const& Handler)
 		{
+			Tune();
 			if (IsAvailable())
 			{
 				++CurrentActive;
 				return true;
 			}
 			QueuedHandlers.Add(Handler);
+			OnHandlerQueued();
 			return false;
 		}
 
@@ -63,7 +65,9 @@ namespace ACETeam_Coroutines
 		void FSemaphore::Release()
 		{
 			check(CurrentActive > 0);
-			if (QueuedHandlers.Num())
+			Tune();
+			//If the limit was lowered below the current active count, don't hand over the slot
+			if (QueuedHandlers.Num() && CurrentActive <= MaxActive)
 			{
 				const FSemaphoreHandlerRef Current = QueuedHandlers[0];
 				QueuedHandlers.RemoveAt(0);
@@ -80,8 +84,15 @@ namespace ACETeam_Coroutines
 			{
 				UE_LOG(LogACETeamCoroutines, Warning, TEXT("Setting max active to a lower value than the currently running coroutines. (NewMax: %d, Current: %d)"), NewMaxActive, CurrentActive);
 			}
-			const int NumToStartNow = FMath::Min(QueuedHandlers.Num(), NewMaxActive-MaxActive);
-			if (CurrentActive == MaxActive && NumToStartNow > 0)
+			ApplyMaxActive(NewMaxActive);
+		}
+
+		void FSemaphore::ApplyMaxActive(int NewMaxActive)
+		{
+			check(NewMaxActive > 0);
+			MaxActive = NewMaxActive;
+			const int NumToStartNow = FMath::Min(QueuedHandlers.Num(), MaxActive-CurrentActive);
+			if (NumToStartNow > 0)
 			{
 				//Split queued handles in two. One part will be started now, the other part will remain queued
 				decltype(QueuedHandlers) ToStart;
@@ -97,12 +108,102 @@ namespace ACETeam_Coroutines
 					NewQueued.Emplace(MoveTemp(QueuedHandlers[i]));
 				}
 				QueuedHandlers = MoveTemp(NewQueued);
+				CurrentActive += NumToStartNow;
 				for (auto const& StartingHandler : ToStart)
 				{
 					StartingHandler->Resume();
 				}
 			}
-			MaxActive = NewMaxActive;
+		}
+
+		FAdaptiveSemaphore::FAdaptiveSemaphore(FAdaptiveSemaphoreSettings const& InSettings)
+			: FSemaphore(FMath::Clamp(InSettings.InitialActive, InSettings.MinActive, InSettings.MaxActive))
+			, Settings(InSettings)
+		{
+			check(Settings.MinActive > 0 && Settings.MinActive <= Settings.MaxActive);
+			check(Settings.MultiplicativeDecrease > 0.0f && Settings.MultiplicativeDecrease < 1.0f);
+		}
+
+		FAdaptiveSemaphore::~FAdaptiveSemaphore()
+		{
+			StopTuneTicker();
+		}
+
+		void FAdaptiveSemaphore::OnHandlerQueued()
+		{
+			StartTuneTicker();
+		}
+
+		void FAdaptiveSemaphore::StartTuneTicker()
+		{
+			if (TuneTickerHandle.IsValid())
+			{
+				return;
+			}
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+			TuneTickerHandle = FTSTicker::GetCoreTicker()
+#else
+			TuneTickerHandle = FTicker::GetCoreTicker()
+#endif
+			.AddTicker(FTickerDelegate::CreateLambda([this](float)
+			{
+				Tune();
+				if (GetQueuedCount() > 0)
+				{
+					return true;
+				}
+				TuneTickerHandle.Reset();
+				return false;
+			}));
+		}
+
+		void FAdaptiveSemaphore::StopTuneTicker()
+		{
+			if (TuneTickerHandle.IsValid())
+			{
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+				FTSTicker::GetCoreTicker().RemoveTicker(TuneTickerHandle);
+#else
+				FTicker::GetCoreTicker().RemoveTicker(TuneTickerHandle);
+#endif
+				TuneTickerHandle.Reset();
+			}
+		}
+
+		void FAdaptiveSemaphore::Tune()
+		{
+			//Only sample once per frame, regardless of how many handlers go through the semaphore
+			if (LastSampleFrame == GFrameCounter)
+			{
+				return;
+			}
+			LastSampleFrame = GFrameCounter;
+			
+			const double Sample = Settings.CostSampler ? Settings.CostSampler() : FPlatformTime::ToSeconds(GGameThreadTime);
+			SmoothedCost = SmoothedCost < 0.0 ? Sample : FMath::Lerp(SmoothedCost, Sample, static_cast<double>(Settings.SmoothingFactor));
+			
+			const double CurrentTime = FPlatformTime::Seconds();
+			if (CurrentTime - LastAdjustTime < Settings.AdjustInterval)
+			{
+				return;
+			}
+			int NewMaxActive = GetMaxActive();
+			if (SmoothedCost > Settings.TargetCost)
+			{
+				NewMaxActive = FMath::FloorToInt(NewMaxActive * Settings.MultiplicativeDecrease);
+			}
+			else if (GetQueuedCount() > 0)
+			{
+				//Only open up when there's demand, otherwise the limit would grow unchecked while idle
+				NewMaxActive += Settings.AdditiveIncrease;
+			}
+			NewMaxActive = FMath::Clamp(NewMaxActive, Settings.MinActive, Settings.MaxActive);
+			if (NewMaxActive != GetMaxActive())
+			{
+				UE_LOG(LogACETeamCoroutines, Verbose, TEXT("Adaptive semaphore limit changed from %d to %d (cost: %.2fms)"), GetMaxActive(), NewMaxActive, SmoothedCost*1000.0);
+				LastAdjustTime = CurrentTime;
+				ApplyMaxActive(NewMaxActive);
+			}
 		}
 	}
 
@@ -115,4 +216,9 @@ namespace ACETeam_Coroutines
 	{
 		return MakeShared<Detail::FSemaphore>(MaxActive);
 	}
+
+	FSemaphoreRef MakeAdaptiveSemaphore(FAdaptiveSemaphoreSettings const& Settings)
+	{
+		return MakeShared<Detail::FAdaptiveSemaphore>(Settings);
+	}
 }
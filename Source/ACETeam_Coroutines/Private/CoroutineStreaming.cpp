@@ -2,59 +2,898 @@
 
 #include "CoroutineExecutor.h"
 #include "Engine/AssetManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/CoreDelegates.h"
+#include "CoroutineLog.h"
 
-ACETeam_Coroutines::Detail::FAssetStreamingNode::FAssetStreamingNode(TFunction<TArray<FSoftObjectPath>()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority)
+static float GStreamingEscalationDelay = 2.0f;
+static FAutoConsoleVariableRef StreamingEscalationDelayCVar (TEXT("ace.Streaming.EscalationDelay"), GStreamingEscalationDelay, TEXT("Seconds a _StreamAssets request that branches are waiting on, queued or in flight, waits before its priority is raised. Zero or less disables escalation"));
+static int32 GStreamingEscalationStep = 25;
+static FAutoConsoleVariableRef StreamingEscalationStepCVar (TEXT("ace.Streaming.EscalationStep"), GStreamingEscalationStep, TEXT("How much the priority of a waited on _StreamAssets request is raised each time it takes too long"));
+static int32 GStreamingMaxEscalatedPriority = FStreamableManager::AsyncLoadHighPriority;
+static FAutoConsoleVariableRef StreamingMaxEscalatedPriorityCVar (TEXT("ace.Streaming.MaxEscalatedPriority"), GStreamingMaxEscalatedPriority, TEXT("Escalation never raises the priority of a _StreamAssets request above this value"));
+static int32 GStreamingDefaultMaxInFlight = 0;
+static FAutoConsoleVariableRef StreamingDefaultMaxInFlightCVar (TEXT("ace.Streaming.DefaultMaxInFlight"), GStreamingDefaultMaxInFlight, TEXT("Maximum number of _StreamAssets requests in flight per category, for categories without an explicit limit. Zero means no limit"));
+static int32 GStreamingPrefetchPriority = FStreamableManager::DefaultAsyncLoadPriority - 50;
+static FAutoConsoleVariableRef StreamingPrefetchPriorityCVar (TEXT("ace.Streaming.PrefetchPriority"), GStreamingPrefetchPriority, TEXT("Priority of the requests issued for _StreamAssets nodes that a sequence is about to reach"));
+//Cleared when the coordinator is destroyed, for nodes that are still alive during static teardown
+static bool GAssetStreamingCoordinatorAlive = false;
+
+ACETeam_Coroutines::Detail::FAssetStreamingNode::FAssetStreamingNode(TFunction<TArray<FSoftObjectPath>()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory, bool bInCanPrefetch)
 :SoftObjectPathGetter(InGetter)
 ,AsyncLoadPriority(InAsyncLoadPriority)
+,Category(InCategory)
+,bCanPrefetch(bInCanPrefetch)
+{
+}
+
+ACETeam_Coroutines::Detail::FAssetStreamingNode::~FAssetStreamingNode()
 {
+	//a sequence that failed before reaching this node never ends it
+	if (PrefetchBatch.IsValid())
+	{
+		if (FAssetStreamingCoordinator* Coordinator = FAssetStreamingCoordinator::TryGet())
+		{
+			Coordinator->ReleaseBatch(PrefetchBatch);
+		}
+	}
 }
 
 ACETeam_Coroutines::EStatus ACETeam_Coroutines::Detail::FAssetStreamingNode::Start(FCoroutineExecutor* Exec)
 {
-	const auto SoftObjectPaths = SoftObjectPathGetter();
-	if (SoftObjectPaths.Num() == 0)
+	//drop what a previous run of this node was holding before joining a new batch
+	ReleaseOwnHandle();
+	RequestedPaths = SoftObjectPathGetter();
+	if (RequestedPaths.Num() == 0)
+		return Completed;
+	if (Batch.IsValid())
+	{
+		FAssetStreamingCoordinator::Get().ReleaseBatch(Batch);
+	}
+	//no need to wait for the end of the frame to join a batch if there's nothing to load
+	if (AreRequestedPathsLoaded())
 		return Completed;
+	if (PrefetchBatch.IsValid() && PrefetchBatch->State == EStreamingBatchState::Completed)
+	{
+		Batch = MoveTemp(PrefetchBatch);
+		return Completed;
+	}
 	CachedExec = Exec;
-	Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(SoftObjectPaths, FStreamableDelegate::CreateLambda([this, Weak = AsWeak()]
+	//an unfinished prefetch is upgraded by requesting the same paths at this node's priority
+	Batch = FAssetStreamingCoordinator::Get().AddRequest(RequestedPaths, AsyncLoadPriority, Category, AsShared());
+	return Suspended;
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingNode::End(FCoroutineExecutor* Exec, EStatus Status)
+{
+	if (Status == Completed)
+	{
+		HoldRequestedPaths();
+	}
+	else
+	{
+		ReleaseOwnHandle();
+	}
+	if (Batch.IsValid())
 	{
-		if (!Weak.IsValid() || Handle->WasCanceled())
-			return;
-		if (CachedExec)
+		FAssetStreamingCoordinator::Get().RemoveWaiter(*Batch, this);
+		if (Status != Completed || !bKeepLoaded)
 		{
-			CachedExec->ForceNodeEnd(this, Completed);
+			FAssetStreamingCoordinator::Get().ReleaseBatch(Batch);
 		}
-	}), AsyncLoadPriority, false, false, TEXT("Coroutine"));
-	if (!Handle.IsValid())
-		return Failed;
-	return Suspended;
+	}
+	if (PrefetchBatch.IsValid())
+	{
+		FAssetStreamingCoordinator::Get().ReleaseBatch(PrefetchBatch);
+	}
+	CachedExec = nullptr;
 }
 
-void ACETeam_Coroutines::Detail::FAssetStreamingNode::End(FCoroutineExecutor* Exec, EStatus Status)
+void ACETeam_Coroutines::Detail::FAssetStreamingNode::Prefetch()
+{
+	if (!bCanPrefetch || CachedExec || PrefetchBatch.IsValid())
+		return;
+	RequestedPaths = SoftObjectPathGetter();
+	if (RequestedPaths.Num() == 0 || AreRequestedPathsLoaded())
+		return;
+	PrefetchBatch = FAssetStreamingCoordinator::Get().AddPrefetchRequest(RequestedPaths, Category);
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingNode::OnBatchUpdated(FStreamingBatch const& UpdatedBatch)
+{
+	if (!CachedExec)
+		return;
+	if (UpdatedBatch.State == EStreamingBatchState::Failed)
+	{
+		//none of the paths could be requested
+		CachedExec->ForceNodeEnd(this, Failed, EWakeSource::Streaming);
+	}
+	else if (UpdatedBatch.State == EStreamingBatchState::Completed || AreRequestedPathsLoaded())
+	{
+		CachedExec->ForceNodeEnd(this, Completed, EWakeSource::Streaming);
+	}
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingNode::HoldRequestedPaths()
+{
+	if (OwnHandle.IsValid())
+		return;
+	TArray<FSoftObjectPath> LoadedPaths;
+	for (auto const& Path : RequestedPaths)
+	{
+		if (Path.IsValid() && Path.ResolveObject() != nullptr)
+		{
+			LoadedPaths.Add(Path);
+		}
+	}
+	if (LoadedPaths.Num() > 0)
+	{
+		//the assets are already resident, so this completes right away and only adds a reference to them
+		OwnHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(LoadedPaths, FStreamableDelegate(), AsyncLoadPriority, false, false, TEXT("Coroutine"));
+	}
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingNode::ReleaseOwnHandle()
+{
+	if (OwnHandle.IsValid())
+	{
+		OwnHandle->ReleaseHandle();
+		OwnHandle.Reset();
+	}
+}
+
+bool ACETeam_Coroutines::Detail::FAssetStreamingNode::AreRequestedPathsLoaded() const
+{
+	for (auto const& Path : RequestedPaths)
+	{
+		if (Path.IsValid() && Path.ResolveObject() == nullptr)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+ACETeam_Coroutines::Detail::FProgressiveStreamingNode::FProgressiveStreamingNode(TArray<FSoftObjectPath> const& InPaths, TArray<FSoftObjectPath> const& InRequiredPaths,
+	TFunction<void(float)> const& InOnProgress, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory)
+:FAssetStreamingNode([InPaths]{ return InPaths; }, InAsyncLoadPriority, InCategory)
+,RequiredPaths(InRequiredPaths)
+,OnProgress(InOnProgress)
+{
+	//the assets that weren't required keep streaming after the node completes
+	bKeepLoaded = true;
+}
+
+ACETeam_Coroutines::EStatus ACETeam_Coroutines::Detail::FProgressiveStreamingNode::Start(FCoroutineExecutor* Exec)
+{
+	//a previous run may still be listening to its batch in the background
+	if (Batch.IsValid())
+	{
+		FAssetStreamingCoordinator::Get().RemoveWaiter(*Batch, this);
+	}
+	LastReportedProgress = -1.0f;
+	const EStatus Status = FAssetStreamingNode::Start(Exec);
+	if (Status == Suspended && AreRequiredPathsLoaded())
+	{
+		ReportProgress();
+		return Completed;
+	}
+	if (Status == Completed && OnProgress)
+	{
+		LastReportedProgress = 1.0f;
+		OnProgress(1.0f);
+	}
+	return Status;
+}
+
+void ACETeam_Coroutines::Detail::FProgressiveStreamingNode::End(FCoroutineExecutor* Exec, EStatus Status)
+{
+	if (Status == Completed && Batch.IsValid() && !Batch->IsFinished())
+	{
+		//stay registered to keep reporting the progress of the assets that are still streaming
+		CachedExec = nullptr;
+		return;
+	}
+	FAssetStreamingNode::End(Exec, Status);
+}
+
+void ACETeam_Coroutines::Detail::FProgressiveStreamingNode::OnBatchUpdated(FStreamingBatch const& UpdatedBatch)
+{
+	ReportProgress();
+	if (!CachedExec)
+		return;
+	if (UpdatedBatch.State == EStreamingBatchState::Failed)
+	{
+		CachedExec->ForceNodeEnd(this, Failed, EWakeSource::Streaming);
+	}
+	else if (UpdatedBatch.State == EStreamingBatchState::Completed || AreRequiredPathsLoaded())
+	{
+		CachedExec->ForceNodeEnd(this, Completed, EWakeSource::Streaming);
+	}
+}
+
+float ACETeam_Coroutines::Detail::FProgressiveStreamingNode::GetProgress() const
+{
+	if (RequestedPaths.Num() == 0 || (Batch.IsValid() && Batch->State == EStreamingBatchState::Completed))
+		return 1.0f;
+	int NumLoaded = 0;
+	for (auto const& Path : RequestedPaths)
+	{
+		if (!Path.IsValid() || Path.ResolveObject() != nullptr)
+		{
+			++NumLoaded;
+		}
+	}
+	return static_cast<float>(NumLoaded) / RequestedPaths.Num();
+}
+
+bool ACETeam_Coroutines::Detail::FProgressiveStreamingNode::AreRequiredPathsLoaded() const
+{
+	if (RequiredPaths.Num() == 0)
+		return AreRequestedPathsLoaded();
+	for (auto const& Path : RequiredPaths)
+	{
+		if (Path.IsValid() && Path.ResolveObject() == nullptr)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void ACETeam_Coroutines::Detail::FProgressiveStreamingNode::ReportProgress()
+{
+	const float Progress = GetProgress();
+	if (Progress != LastReportedProgress)
+	{
+		LastReportedProgress = Progress;
+		if (OnProgress)
+		{
+			OnProgress(Progress);
+		}
+	}
+}
+
+ACETeam_Coroutines::Detail::FAssetStreamingCoordinator& ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::Get()
+{
+	static FAssetStreamingCoordinator Instance;
+	return Instance;
+}
+
+ACETeam_Coroutines::Detail::FAssetStreamingCoordinator* ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::TryGet()
+{
+	return GAssetStreamingCoordinatorAlive ? &Get() : nullptr;
+}
+
+ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::FAssetStreamingCoordinator()
+{
+	GAssetStreamingCoordinatorAlive = true;
+}
+
+ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::~FAssetStreamingCoordinator()
+{
+	GAssetStreamingCoordinatorAlive = false;
+}
+
+TSharedRef<ACETeam_Coroutines::Detail::FStreamingBatch> ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::AddRequest(
+	TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category, TSharedRef<FAssetStreamingNode, DefaultSPMode> const& Waiter)
+{
+	TSharedRef<FStreamingBatch> Batch = AddToPendingBatch(Paths, Priority, Category);
+	Batch->Waiters.Add(Waiter);
+	return Batch;
+}
+
+TSharedRef<ACETeam_Coroutines::Detail::FStreamingBatch> ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::AddPrefetchRequest(TArray<FSoftObjectPath> const& Paths, FName Category)
+{
+	return AddToPendingBatch(Paths, GStreamingPrefetchPriority, Category);
+}
+
+TSharedRef<ACETeam_Coroutines::Detail::FStreamingBatch> ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::AddToPendingBatch(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category)
+{
+	check(IsInGameThread());
+	const TPair<TAsyncLoadPriority, FName> Key(Priority, Category);
+	TSharedRef<FStreamingBatch>* PendingBatch = PendingBatches.Find(Key);
+	if (!PendingBatch)
+	{
+		PendingBatch = &PendingBatches.Add(Key, MakeShared<FStreamingBatch>(Priority, Category));
+	}
+	FStreamingBatch& Batch = PendingBatch->Get();
+	for (auto const& Path : Paths)
+	{
+		bool bAlreadyInBatch = false;
+		Batch.PathSet.Add(Path, &bAlreadyInBatch);
+		if (!bAlreadyInBatch)
+		{
+			Batch.Paths.Add(Path);
+		}
+	}
+	ScheduleFlush();
+	return *PendingBatch;
+}
+
+TSharedRef<ACETeam_Coroutines::Detail::FStreamingBatch> ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::AddUnsharedRequest(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category)
+{
+	check(IsInGameThread());
+	const TSharedRef<FStreamingBatch> Batch = MakeShared<FStreamingBatch>(Priority, Category);
+	Batch->Paths = Paths;
+	//skips the pending batches, but is still issued at the end of the frame along with them
+	Enqueue(Batch);
+	ScheduleFlush();
+	return Batch;
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::RaisePriority(TSharedRef<FStreamingBatch> const& Batch, TAsyncLoadPriority NewPriority, TArray<FSoftObjectPath> const& PathsToBoost)
+{
+	//pending batches are keyed by their priority, and are issued at the end of the frame anyway
+	if (NewPriority <= Batch->Priority || Batch->State == EStreamingBatchState::Pending || Batch->IsFinished())
+		return;
+	Batch->Priority = NewPriority;
+	if (Batch->State == EStreamingBatchState::Queued)
+	{
+		Categories.FindChecked(Batch->Category).Queue.StableSort([](TSharedRef<FStreamingBatch> const& A, TSharedRef<FStreamingBatch> const& B) { return A->Priority > B->Priority; });
+		return;
+	}
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (auto const& Path : PathsToBoost)
+	{
+		if (Path.IsValid() && Path.ResolveObject() == nullptr)
+		{
+			PathsToLoad.Add(Path);
+		}
+	}
+	if (PathsToLoad.Num() > 0)
+	{
+		if (Batch->BoostHandle.IsValid())
+		{
+			Batch->BoostHandle->ReleaseHandle();
+		}
+		Batch->BoostHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(PathsToLoad, FStreamableDelegate(), NewPriority, false, false, TEXT("Coroutine"));
+	}
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::AddWaiter(FStreamingBatch& Batch, TSharedRef<FAssetStreamingNode, DefaultSPMode> const& Waiter)
+{
+	Batch.Waiters.Add(Waiter);
+	ScheduleEscalation();
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::RemoveWaiter(FStreamingBatch& Batch, FAssetStreamingNode* Waiter)
+{
+	Batch.Waiters.RemoveAllSwap([Waiter](TWeakPtr<FAssetStreamingNode, DefaultSPMode> const& Weak)
+	{
+		return !Weak.IsValid() || Weak.Pin().Get() == Waiter;
+	});
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::ReleaseBatch(TSharedPtr<FStreamingBatch>& Batch)
+{
+	const TSharedRef<FStreamingBatch> BatchRef = Batch.ToSharedRef();
+	Batch.Reset();
+	//the coordinator's own list holds the other reference, so there are no more users of this batch
+	if (BatchRef->IsFinished() || BatchRef->Waiters.Num() > 0 || BatchRef.GetSharedReferenceCount() != 2)
+		return;
+	switch (BatchRef->State)
+	{
+	case EStreamingBatchState::Pending:
+		PendingBatches.Remove(TPair<TAsyncLoadPriority, FName>(BatchRef->Priority, BatchRef->Category));
+		break;
+	case EStreamingBatchState::Queued:
+		Categories.FindChecked(BatchRef->Category).Queue.RemoveSingle(BatchRef);
+		break;
+	case EStreamingBatchState::InFlight:
+		BatchRef->State = EStreamingBatchState::Failed;
+		BatchRef->Handle->CancelHandle();
+		if (BatchRef->BoostHandle.IsValid())
+		{
+			BatchRef->BoostHandle->CancelHandle();
+		}
+		InFlightBatches.RemoveSingleSwap(BatchRef);
+		--Categories.FindChecked(BatchRef->Category).NumInFlight;
+		//this is usually reached from a node ending, so the freed slot is filled later. A request that completes
+		//right away would otherwise wake its waiters from inside the executor's End call
+		ScheduleFlush();
+		break;
+	default:
+		break;
+	}
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::SetCategoryLimit(FName Category, int MaxInFlight)
+{
+	check(IsInGameThread());
+	Categories.FindOrAdd(Category).MaxInFlight = MaxInFlight;
+	ScheduleFlush();
+}
+
+int ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::GetNumQueued(FName Category) const
+{
+	const FCategoryState* CategoryState = Categories.Find(Category);
+	return CategoryState ? CategoryState->Queue.Num() : 0;
+}
+
+int ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::GetNumInFlight(FName Category) const
+{
+	const FCategoryState* CategoryState = Categories.Find(Category);
+	return CategoryState ? CategoryState->NumInFlight : 0;
+}
+
+int ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::GetMaxInFlight(FCategoryState const& CategoryState) const
+{
+	return CategoryState.MaxInFlight.Get(GStreamingDefaultMaxInFlight);
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::ScheduleFlush()
+{
+	if (!EndFrameHandle.IsValid())
+	{
+		EndFrameHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FAssetStreamingCoordinator::Flush);
+	}
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::Flush()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FAssetStreamingCoordinator::Flush);
+	FCoreDelegates::OnEndFrame.Remove(EndFrameHandle);
+	EndFrameHandle.Reset();
+	
+	auto BatchesToRequest = MoveTemp(PendingBatches);
+	PendingBatches.Reset();
+	for (auto& Pair : BatchesToRequest)
+	{
+		Pair.Value->PathSet.Empty();
+		Enqueue(Pair.Value);
+	}
+	IssueQueuedRequests();
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::Enqueue(TSharedRef<FStreamingBatch> const& Batch)
 {
-	if (Status == Aborted)
+	Batch->State = EStreamingBatchState::Queued;
+	Batch->LastEscalationTime = FPlatformTime::Seconds();
+	auto& Queue = Categories.FindOrAdd(Batch->Category).Queue;
+	//keep the queue sorted, behind everything with the same priority
+	int Index = 0;
+	while (Index < Queue.Num() && Queue[Index]->Priority >= Batch->Priority)
 	{
-		if (Handle.IsValid())
+		++Index;
+	}
+	Queue.Insert(Batch, Index);
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::IssueQueuedRequests()
+{
+	//requests that finish right away, and the waiters they wake, can get back here. Let the outer call pick up their changes
+	if (bIssuingRequests)
+	{
+		bIssueAgain = true;
+		return;
+	}
+	TGuardValue<bool> IssuingGuard(bIssuingRequests, true);
+	do
+	{
+		bIssueAgain = false;
+		for (auto& Pair : Categories)
 		{
-			Handle->CancelHandle();
-			Handle.Reset();
+			FCategoryState& CategoryState = Pair.Value;
+			while (CategoryState.Queue.Num() > 0)
+			{
+				const int MaxInFlight = GetMaxInFlight(CategoryState);
+				if (MaxInFlight > 0 && CategoryState.NumInFlight >= MaxInFlight)
+					break;
+				const TSharedRef<FStreamingBatch> Batch = CategoryState.Queue[0];
+				CategoryState.Queue.RemoveAt(0);
+				Request(Batch);
+			}
 		}
 	}
+	while (bIssueAgain);
+	ScheduleEscalation();
+}
+
+bool ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::HasWaitedRequests() const
+{
+	auto HasWaiters = [](TSharedRef<FStreamingBatch> const& Batch) { return Batch->Waiters.Num() > 0; };
+	for (auto const& Pair : Categories)
+	{
+		if (Pair.Value.Queue.ContainsByPredicate(HasWaiters))
+			return true;
+	}
+	return InFlightBatches.ContainsByPredicate(HasWaiters);
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::ScheduleEscalation()
+{
+	if (EscalationHandle.IsValid() || GStreamingEscalationDelay <= 0.0f || !HasWaitedRequests())
+		return;
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+	EscalationHandle = FTSTicker::GetCoreTicker()
+#else
+	EscalationHandle = FTicker::GetCoreTicker()
+#endif
+	.AddTicker(FTickerDelegate::CreateRaw(this, &FAssetStreamingCoordinator::EscalateWaitedRequests), GStreamingEscalationDelay * 0.5f);
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::Request(TSharedRef<FStreamingBatch> const& Batch)
+{
+	Batch->State = EStreamingBatchState::InFlight;
+	++Categories.FindChecked(Batch->Category).NumInFlight;
+	InFlightBatches.Add(Batch);
+	TWeakPtr<FStreamingBatch> WeakBatch = Batch;
+	Batch->Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Batch->Paths, FStreamableDelegate::CreateLambda([this, WeakBatch]
+	{
+		if (auto PinnedBatch = WeakBatch.Pin())
+		{
+			//if this is called from within RequestAsyncLoad, completion is handled right after it returns
+			if (PinnedBatch->Handle.IsValid() && PinnedBatch->State == EStreamingBatchState::InFlight && !PinnedBatch->Handle->WasCanceled())
+			{
+				OnBatchFinished(PinnedBatch.ToSharedRef(), EStreamingBatchState::Completed);
+			}
+		}
+	}), Batch->Priority, false, false, TEXT("Coroutine"));
+	if (!Batch->Handle.IsValid())
+	{
+		OnBatchFinished(Batch, EStreamingBatchState::Failed);
+		return;
+	}
+	Batch->Handle->BindUpdateDelegate(FStreamableUpdateDelegate::CreateLambda([this, WeakBatch](TSharedRef<FStreamableHandle>)
+	{
+		if (auto PinnedBatch = WeakBatch.Pin())
+		{
+			if (PinnedBatch->State == EStreamingBatchState::InFlight)
+			{
+				NotifyWaiters(PinnedBatch.ToSharedRef());
+			}
+		}
+	}));
+	if (Batch->Handle->HasLoadCompleted())
+	{
+		OnBatchFinished(Batch, EStreamingBatchState::Completed);
+	}
+}
+
+bool ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::EscalateWaitedRequests(float)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FAssetStreamingCoordinator::EscalateWaitedRequests);
+	const double Now = FPlatformTime::Seconds();
+	//prefetches nobody is waiting for yet keep their low priority
+	auto IsDue = [Now](FStreamingBatch const& Batch)
+	{
+		return Batch.Waiters.Num() > 0 && Batch.Priority < GStreamingMaxEscalatedPriority && Now - Batch.LastEscalationTime >= GStreamingEscalationDelay;
+	};
+	auto EscalatedPriority = [](FStreamingBatch const& Batch)
+	{
+		return FMath::Min<TAsyncLoadPriority>(Batch.Priority + GStreamingEscalationStep, GStreamingMaxEscalatedPriority);
+	};
+	for (auto& Pair : Categories)
+	{
+		bool bEscalated = false;
+		for (auto const& Batch : Pair.Value.Queue)
+		{
+			if (IsDue(*Batch))
+			{
+				Batch->Priority = EscalatedPriority(*Batch);
+				Batch->LastEscalationTime = Now;
+				bEscalated = true;
+				UE_LOG(LogACETeamCoroutines, Verbose, TEXT("Raised priority of queued streaming request in category %s to %d"), *Pair.Key.ToString(), Batch->Priority);
+			}
+		}
+		if (bEscalated)
+		{
+			Pair.Value.Queue.StableSort([](TSharedRef<FStreamingBatch> const& A, TSharedRef<FStreamingBatch> const& B) { return A->Priority > B->Priority; });
+		}
+	}
+	//categories without a limit never queue, so requests that take too long in flight are escalated too.
+	//Only the paths the waiting branches still need are requested again, not the whole batch
+	const auto BatchesInFlight = InFlightBatches;
+	for (auto const& Batch : BatchesInFlight)
+	{
+		if (!IsDue(*Batch))
+			continue;
+		TArray<FSoftObjectPath> WaitedPaths;
+		for (auto const& Weak : Batch->Waiters)
+		{
+			if (auto Waiter = Weak.Pin())
+			{
+				WaitedPaths.Append(Waiter->RequestedPaths);
+			}
+		}
+		Batch->LastEscalationTime = Now;
+		RaisePriority(Batch, EscalatedPriority(*Batch), WaitedPaths);
+		UE_LOG(LogACETeamCoroutines, Verbose, TEXT("Raised priority of streaming request in flight in category %s to %d"), *Batch->Category.ToString(), Batch->Priority);
+	}
+	if (GStreamingEscalationDelay <= 0.0f || !HasWaitedRequests())
+	{
+		EscalationHandle.Reset();
+		return false;
+	}
+	return true;
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::NotifyWaiters(TSharedRef<FStreamingBatch> const& Batch)
+{
+	//waking a node can start or abort others that wait on this same batch, so iterate over a copy
+	const auto Waiters = Batch->Waiters;
+	for (auto const& Weak : Waiters)
+	{
+		if (auto Waiter = Weak.Pin())
+		{
+			Waiter->OnBatchUpdated(*Batch);
+		}
+	}
+}
+
+void ACETeam_Coroutines::Detail::FAssetStreamingCoordinator::OnBatchFinished(TSharedRef<FStreamingBatch> const& Batch, EStreamingBatchState FinalState)
+{
+	Batch->State = FinalState;
+	if (Batch->BoostHandle.IsValid())
+	{
+		Batch->BoostHandle->ReleaseHandle();
+		Batch->BoostHandle.Reset();
+	}
+	InFlightBatches.RemoveSingleSwap(Batch);
+	--Categories.FindChecked(Batch->Category).NumInFlight;
+	NotifyWaiters(Batch);
+	Batch->Waiters.Reset();
+	//the freed slot is only filled right away when this finished while issuing requests, otherwise it waits for the end of the frame
+	if (bIssuingRequests)
+	{
+		bIssueAgain = true;
+	}
+	else
+	{
+		ScheduleFlush();
+	}
+}
+
+ACETeam_Coroutines::Detail::FResidentAssetWaitNode::FResidentAssetWaitNode(TArray<FSoftObjectPath> const& InPaths, TArray<TSharedRef<FStreamingBatch>>&& InPendingBatches)
+:FAssetStreamingNode([InPaths]{ return InPaths; }, FStreamableManager::DefaultAsyncLoadPriority)
+,PendingBatches(MoveTemp(InPendingBatches))
+{
+}
+
+ACETeam_Coroutines::EStatus ACETeam_Coroutines::Detail::FResidentAssetWaitNode::Start(FCoroutineExecutor* Exec)
+{
+	RequestedPaths = SoftObjectPathGetter();
+	const EStatus Status = GetPendingBatchesStatus();
+	if (Status != Suspended)
+		return Status;
+	CachedExec = Exec;
+	for (auto const& PendingBatch : PendingBatches)
+	{
+		if (!PendingBatch->IsFinished())
+		{
+			FAssetStreamingCoordinator::Get().AddWaiter(*PendingBatch, AsShared());
+		}
+	}
+	return Suspended;
+}
+
+void ACETeam_Coroutines::Detail::FResidentAssetWaitNode::End(FCoroutineExecutor* Exec, EStatus Status)
+{
+	for (auto const& PendingBatch : PendingBatches)
+	{
+		FAssetStreamingCoordinator::Get().RemoveWaiter(*PendingBatch, this);
+	}
+	//the cache is the one keeping the requests alive, and it can only cancel them once nobody else holds them.
+	//It also keeps the assets referenced afterwards, so there's no need for a handle of this node's own
+	PendingBatches.Reset();
 	CachedExec = nullptr;
 }
 
-ACETeam_Coroutines::FCoroutineNodeRef ACETeam_Coroutines::_StreamAssets(TArray<FSoftObjectPath> const& SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority)
+void ACETeam_Coroutines::Detail::FResidentAssetWaitNode::OnBatchUpdated(FStreamingBatch const& UpdatedBatch)
 {
-	return MakeShared<Detail::FAssetStreamingNode, DefaultSPMode>([=]{ return SoftObjectPaths; }, AsyncLoadPriority);
+	if (!CachedExec)
+		return;
+	const EStatus Status = GetPendingBatchesStatus();
+	if (Status != Suspended)
+	{
+		CachedExec->ForceNodeEnd(this, Status, EWakeSource::Streaming);
+	}
+}
+
+ACETeam_Coroutines::EStatus ACETeam_Coroutines::Detail::FResidentAssetWaitNode::GetPendingBatchesStatus() const
+{
+	bool bAllFinished = true;
+	for (auto const& PendingBatch : PendingBatches)
+	{
+		if (PendingBatch->State == EStreamingBatchState::Failed)
+			return Failed;
+		bAllFinished &= PendingBatch->IsFinished();
+	}
+	return bAllFinished || AreRequestedPathsLoaded() ? Completed : Suspended;
+}
+
+ACETeam_Coroutines::Detail::FResidentAssetCache& ACETeam_Coroutines::Detail::FResidentAssetCache::Get()
+{
+	static FResidentAssetCache Instance;
+	return Instance;
+}
+
+void ACETeam_Coroutines::Detail::FResidentAssetCache::AddReferences(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category, TArray<TSharedRef<FStreamingBatch>>& OutPendingBatches)
+{
+	check(IsInGameThread());
+	TArray<FSoftObjectPath> PathsToLoad;
+	for (auto const& Path : Paths)
+	{
+		FEntry& Entry = Entries.FindOrAdd(Path);
+		++Entry.RefCount;
+		if (Entry.Handle.IsValid())
+			continue;
+		//a request that failed doesn't keep anything loaded, so it's tried again
+		if (!Entry.Batch.IsValid() || Entry.Batch->State == EStreamingBatchState::Failed)
+		{
+			Entry.Batch.Reset();
+			PathsToLoad.AddUnique(Path);
+		}
+		else if (Entry.Batch->State == EStreamingBatchState::Completed)
+		{
+			HoldLoadedPath(Path, Entry);
+		}
+		else
+		{
+			OutPendingBatches.AddUnique(Entry.Batch.ToSharedRef());
+		}
+	}
+	//this scope shouldn't wait behind the priority of the scopes that requested its paths first
+	for (auto const& PendingBatch : OutPendingBatches)
+	{
+		FAssetStreamingCoordinator::Get().RaisePriority(PendingBatch, Priority, PendingBatch->Paths);
+	}
+	if (PathsToLoad.Num() > 0)
+	{
+		const TSharedRef<FStreamingBatch> Batch = FAssetStreamingCoordinator::Get().AddUnsharedRequest(PathsToLoad, Priority, Category);
+		for (auto const& Path : PathsToLoad)
+		{
+			Entries.FindChecked(Path).Batch = Batch;
+		}
+		OutPendingBatches.Add(Batch);
+	}
+}
+
+void ACETeam_Coroutines::Detail::FResidentAssetCache::HoldLoadedPaths(TArray<FSoftObjectPath> const& Paths)
+{
+	check(IsInGameThread());
+	for (auto const& Path : Paths)
+	{
+		FEntry* Entry = Entries.Find(Path);
+		if (Entry && !Entry->Handle.IsValid() && Entry->Batch.IsValid() && Entry->Batch->State == EStreamingBatchState::Completed)
+		{
+			HoldLoadedPath(Path, *Entry);
+		}
+	}
+}
+
+void ACETeam_Coroutines::Detail::FResidentAssetCache::HoldLoadedPath(FSoftObjectPath const& Path, FEntry& Entry)
+{
+	//already resident, so this completes right away. Paths that didn't load are requested again by the next scope
+	if (Path.IsValid() && Path.ResolveObject() != nullptr)
+	{
+		Entry.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Path, FStreamableDelegate(), FStreamableManager::DefaultAsyncLoadPriority, false, false, TEXT("Coroutine"));
+	}
+	FAssetStreamingCoordinator::Get().ReleaseBatch(Entry.Batch);
+}
+
+void ACETeam_Coroutines::Detail::FResidentAssetCache::RemoveReferences(TArray<FSoftObjectPath> const& Paths)
+{
+	check(IsInGameThread());
+	for (auto const& Path : Paths)
+	{
+		FEntry* Entry = Entries.Find(Path);
+		if (ensure(Entry) && --Entry->RefCount == 0)
+		{
+			TSharedPtr<FStreamingBatch> Batch = MoveTemp(Entry->Batch);
+			if (Entry->Handle.IsValid())
+			{
+				Entry->Handle->ReleaseHandle();
+			}
+			Entries.Remove(Path);
+			//cancels the request if it's still loading and none of its other paths are referenced anymore.
+			//Otherwise the path is let go as soon as the request finishes, when the other paths take their own handles
+			if (Batch.IsValid())
+			{
+				FAssetStreamingCoordinator::Get().ReleaseBatch(Batch);
+			}
+		}
+	}
+}
+
+ACETeam_Coroutines::Detail::FAssetScopeNode::FAssetScopeNode(TFunction<TArray<FSoftObjectPath>()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory)
+:SoftObjectPathGetter(InGetter)
+,AsyncLoadPriority(InAsyncLoadPriority)
+,Category(InCategory)
+{
+}
+
+void ACETeam_Coroutines::Detail::FAssetScopeNode::ReleaseReferences()
+{
+	if (bHoldsReferences)
+	{
+		bHoldsReferences = false;
+		FResidentAssetCache::Get().RemoveReferences(ReferencedPaths);
+	}
+}
+
+ACETeam_Coroutines::EStatus ACETeam_Coroutines::Detail::FAssetScopeNode::Start(FCoroutineExecutor* Exec)
+{
+	ReferencedPaths = SoftObjectPathGetter();
+	TArray<TSharedRef<FStreamingBatch>> PendingBatches;
+	FResidentAssetCache::Get().AddReferences(ReferencedPaths, AsyncLoadPriority, Category, PendingBatches);
+	bHoldsReferences = true;
+	if (PendingBatches.Num() == 0)
+	{
+		return FCoroutineDecorator::Start(Exec);
+	}
+	LoadNode = MakeShared<FResidentAssetWaitNode, DefaultSPMode>(ReferencedPaths, MoveTemp(PendingBatches));
+	Exec->EnqueueCoroutineNode(LoadNode.ToSharedRef(), this);
+	return Suspended;
+}
+
+ACETeam_Coroutines::EStatus ACETeam_Coroutines::Detail::FAssetScopeNode::OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child)
+{
+	if (LoadNode.IsValid() && Child == LoadNode.Get())
+	{
+		LoadNode.Reset();
+		if (Status != Completed)
+		{
+			ReleaseReferences();
+			return Status;
+		}
+		FResidentAssetCache::Get().HoldLoadedPaths(ReferencedPaths);
+		return FCoroutineDecorator::Start(Exec);
+	}
+	ReleaseReferences();
+	return Status;
+}
+
+void ACETeam_Coroutines::Detail::FAssetScopeNode::End(FCoroutineExecutor* Exec, EStatus Status)
+{
+	if (Status == Aborted && LoadNode.IsValid())
+	{
+		Exec->AbortNode(LoadNode.ToSharedRef());
+	}
+	else
+	{
+		FCoroutineDecorator::End(Exec, Status);
+	}
+	LoadNode.Reset();
+	ReleaseReferences();
+}
+
+ACETeam_Coroutines::FCoroutineNodeRef ACETeam_Coroutines::_StreamAssets(TArray<FSoftObjectPath> const& SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority, FName Category)
+{
+	return MakeShared<Detail::FAssetStreamingNode, DefaultSPMode>([=]{ return SoftObjectPaths; }, AsyncLoadPriority, Category, true);
 }
 
 ACETeam_Coroutines::FCoroutineNodeRef ACETeam_Coroutines::_StreamAssets(
-	std::initializer_list<FSoftObjectPath> SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority)
+	std::initializer_list<FSoftObjectPath> SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority, FName Category)
 {
-	return MakeShared<Detail::FAssetStreamingNode, DefaultSPMode>([Array = TArray(SoftObjectPaths)]{ return Array; }, AsyncLoadPriority);
+	return MakeShared<Detail::FAssetStreamingNode, DefaultSPMode>([Array = TArray(SoftObjectPaths)]{ return Array; }, AsyncLoadPriority, Category, true);
 }
 
 ACETeam_Coroutines::FCoroutineNodeRef ACETeam_Coroutines::_StreamAssets(
-	TFunction<TArray<FSoftObjectPath>()> SoftObjectPathsGetter, TAsyncLoadPriority AsyncLoadPriority)
+	TFunction<TArray<FSoftObjectPath>()> SoftObjectPathsGetter, TAsyncLoadPriority AsyncLoadPriority, FName Category)
+{
+	return MakeShared<Detail::FAssetStreamingNode, DefaultSPMode>(SoftObjectPathsGetter, AsyncLoadPriority, Category);
+}
+
+ACETeam_Coroutines::FCoroutineNodeRef ACETeam_Coroutines::_StreamAssetsWithProgress(TArray<FSoftObjectPath> const& SoftObjectPaths, TFunction<void(float)> OnProgress,
+	TArray<FSoftObjectPath> const& RequiredPaths, TAsyncLoadPriority AsyncLoadPriority, FName Category)
+{
+	return MakeShared<Detail::FProgressiveStreamingNode, DefaultSPMode>(SoftObjectPaths, RequiredPaths, OnProgress, AsyncLoadPriority, Category);
+}
+
+ACETeam_Coroutines::FCoroutineNodeRef ACETeam_Coroutines::_StreamAssetsWithProgress(TArray<FSoftObjectPath> const& SoftObjectPaths, TCoroVar<float> Progress,
+	TArray<FSoftObjectPath> const& RequiredPaths, TAsyncLoadPriority AsyncLoadPriority, FName Category)
+{
+	return _StreamAssetsWithProgress(SoftObjectPaths, [Progress](float Value) { *Progress = Value; }, RequiredPaths, AsyncLoadPriority, Category);
+}
+
+ACETeam_Coroutines::Detail::FAssetScopeHelper ACETeam_Coroutines::_AssetScope(TArray<FSoftObjectPath> const& SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority, FName Category)
+{
+	return Detail::FAssetScopeHelper([=]{ return SoftObjectPaths; }, AsyncLoadPriority, Category);
+}
+
+ACETeam_Coroutines::Detail::FAssetScopeHelper ACETeam_Coroutines::_AssetScope(TFunction<TArray<FSoftObjectPath>()> SoftObjectPathsGetter, TAsyncLoadPriority AsyncLoadPriority, FName Category)
 {
-	return MakeShared<Detail::FAssetStreamingNode, DefaultSPMode>(SoftObjectPathsGetter, AsyncLoadPriority);
+	return Detail::FAssetScopeHelper(SoftObjectPathsGetter, AsyncLoadPriority, Category);
 }
@@ -0,0 +1,38 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineTraces.h"
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		static UWorld* GetTraceWorld(UObject* WorldContextObject)
+		{
+			return WorldContextObject && GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+		}
+
+		bool RequestAsyncLineTrace(UObject* WorldContextObject, EAsyncTraceType TraceType, FVector const& Start, FVector const& End,
+			FAsyncTraceSettings const& Settings, FTraceDelegate const& Delegate)
+		{
+			UWorld* World = GetTraceWorld(WorldContextObject);
+			if (!World)
+				return false;
+			FTraceDelegate DelegateCopy = Delegate;
+			World->AsyncLineTraceByChannel(TraceType, Start, End, Settings.Channel, Settings.Params, Settings.ResponseParams, &DelegateCopy);
+			return true;
+		}
+
+		bool RequestAsyncOverlap(UObject* WorldContextObject, FVector const& Position, FQuat const& Rotation, FCollisionShape const& Shape,
+			FAsyncTraceSettings const& Settings, FOverlapDelegate const& Delegate)
+		{
+			UWorld* World = GetTraceWorld(WorldContextObject);
+			if (!World)
+				return false;
+			FOverlapDelegate DelegateCopy = Delegate;
+			World->AsyncOverlapByChannel(Position, Rotation, Settings.Channel, Shape, Settings.Params, Settings.ResponseParams, &DelegateCopy);
+			return true;
+		}
+	}
+}
@@ -0,0 +1,107 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#include "CoroutineWakeLatency.h"
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+#include "CoroutineLog.h"
+#include "HAL/IConsoleManager.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		//Upper bounds of the time buckets, in milliseconds. Anything longer goes in the last one
+		static const double GWakeLatencyMsBounds[] = { 0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 33.0, 66.0, 133.0 };
+		static const int32 NumWakeLatencyMsBuckets = UE_ARRAY_COUNT(GWakeLatencyMsBounds) + 1;
+		//Steps are counted one by one, up to the last bucket
+		static const int32 NumWakeLatencyStepBuckets = 5;
+
+		struct FWakeLatencyHistogram
+		{
+			int32 Count = 0;
+			double TotalSeconds = 0.0;
+			double MaxSeconds = 0.0;
+			int32 MsBuckets[NumWakeLatencyMsBuckets] = {};
+			int32 StepBuckets[NumWakeLatencyStepBuckets] = {};
+		};
+
+		static FWakeLatencyHistogram GWakeLatency[static_cast<int32>(EWakeSource::Count)];
+
+		static int32 GWakeLatencyEnabled = 0;
+		static FAutoConsoleVariableRef WakeLatencyCVar (TEXT("ace.Coroutines.WakeLatency"), GWakeLatencyEnabled, TEXT("If set, the time between a coroutine being woken up by an event, async result, streaming or semaphore and it resuming is recorded for ace.Coroutines.WakeLatencyReport"));
+
+		static void WakeLatencyReport()
+		{
+			FString MsHeader;
+			for (double Bound : GWakeLatencyMsBounds)
+			{
+				MsHeader += FString::Printf(TEXT(" %7s"), *FString::Printf(TEXT("<%g"), Bound));
+			}
+			MsHeader += FString::Printf(TEXT(" %7s"), TEXT("more"));
+			FString StepHeader;
+			for (int32 Steps = 0; Steps < NumWakeLatencyStepBuckets; ++Steps)
+			{
+				StepHeader += FString::Printf(Steps + 1 < NumWakeLatencyStepBuckets ? TEXT(" %4d") : TEXT(" %3d+"), Steps);
+			}
+			UE_LOG(LogACETeamCoroutines, Display, TEXT("Coroutine wake-up latency:"));
+			UE_LOG(LogACETeamCoroutines, Display, TEXT("%-10s %8s %9s %9s |%s (ms) |%s (steps)"), TEXT("Source"), TEXT("Count"), TEXT("Avg (ms)"), TEXT("Max (ms)"), *MsHeader, *StepHeader);
+			for (int32 Source = 1; Source < static_cast<int32>(EWakeSource::Count); ++Source)
+			{
+				const FWakeLatencyHistogram& Histogram = GWakeLatency[Source];
+				if (Histogram.Count == 0)
+					continue;
+				FString MsBuckets;
+				for (int32 Bucket : Histogram.MsBuckets)
+				{
+					MsBuckets += FString::Printf(TEXT(" %7d"), Bucket);
+				}
+				FString StepBuckets;
+				for (int32 Bucket : Histogram.StepBuckets)
+				{
+					StepBuckets += FString::Printf(TEXT(" %4d"), Bucket);
+				}
+				UE_LOG(LogACETeamCoroutines, Display, TEXT("%-10s %8d %9.3f %9.3f |%s      |%s"), ToString(static_cast<EWakeSource>(Source)), Histogram.Count,
+					Histogram.TotalSeconds * 1000.0 / Histogram.Count, Histogram.MaxSeconds * 1000.0, *MsBuckets, *StepBuckets);
+			}
+		}
+
+		static void WakeLatencyReset()
+		{
+			for (FWakeLatencyHistogram& Histogram : GWakeLatency)
+			{
+				Histogram = FWakeLatencyHistogram();
+			}
+		}
+
+		static FAutoConsoleCommand WakeLatencyReportCmd(
+			TEXT("ace.Coroutines.WakeLatencyReport"),
+			TEXT("Logs the histograms of the time and executor steps coroutines took to resume after being woken up, for each kind of wake-up"),
+			FConsoleCommandDelegate::CreateStatic(&WakeLatencyReport));
+
+		static FAutoConsoleCommand WakeLatencyResetCmd(
+			TEXT("ace.Coroutines.WakeLatencyReset"),
+			TEXT("Clears the coroutine wake-up latency histograms"),
+			FConsoleCommandDelegate::CreateStatic(&WakeLatencyReset));
+	}
+}
+
+bool ACETeam_Coroutines::Detail::IsWakeLatencyEnabled()
+{
+	return GWakeLatencyEnabled != 0;
+}
+
+void ACETeam_Coroutines::Detail::AddWakeLatency(EWakeSource Source, double Seconds, int32 Steps)
+{
+	FWakeLatencyHistogram& Histogram = GWakeLatency[static_cast<int32>(Source)];
+	++Histogram.Count;
+	Histogram.TotalSeconds += Seconds;
+	Histogram.MaxSeconds = FMath::Max(Histogram.MaxSeconds, Seconds);
+	const double Ms = Seconds * 1000.0;
+	int32 MsBucket = 0;
+	while (MsBucket < NumWakeLatencyMsBuckets - 1 && Ms >= GWakeLatencyMsBounds[MsBucket])
+	{
+		++MsBucket;
+	}
+	++Histogram.MsBuckets[MsBucket];
+	++Histogram.StepBuckets[FMath::Clamp(Steps, 0, NumWakeLatencyStepBuckets - 1)];
+}
+#endif
@@ -0,0 +1,17 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineExecutor.h"
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		//Latencies are recorded while ace.Coroutines.WakeLatency is set, and while the Coroutines trace channel is enabled
+		bool IsWakeLatencyEnabled();
+		//Time and executor steps between a branch being woken up and it resuming, added to the histograms of its source
+		void AddWakeLatency(EWakeSource Source, double Seconds, int32 Steps);
+	}
+}
+#endif
@@ -46,6 +46,8 @@ TSharedRef<FGameplayDebuggerCategory> FGameplayDebuggerCategory_Coroutines::Make
 void FGameplayDebuggerCategory_Coroutines::DrawData(APlayerController* OwnerPC,
 	FGameplayDebuggerCanvasContext& CanvasContext)
 {
+	FCoroutineExecutor::RequestDebuggerTracking();
+
 	CanvasContext.Printf(TEXT("\n[{yellow}%s{white}] Toggle Compact mode"), *GetInputHandlerDescription(0));
 	CanvasContext.Printf(TEXT("\n[{yellow}%s{white}] Scroll down"), *GetInputHandlerDescription(1));
 	CanvasContext.Printf(TEXT("\n[{yellow}%s{white}] Scroll up"), *GetInputHandlerDescription(2));
@@ -117,15 +119,13 @@ void FGameplayDebuggerCategory_Coroutines::DrawData(APlayerController* OwnerPC,
 
 	struct FScopeInfo
 	{
-		FCoroutineNode* Scope;
 		double Y;
 		double Indent;
-		bool operator==(FCoroutineNode* InScope) const { return Scope == InScope; }
 	};
-	TArray<FScopeInfo> ScopeInfo;
+	TMap<FCoroutineNode*, FScopeInfo> ScopeInfo;
 	auto HeightForScope = [&](FCoroutineNode* Scope)
 	{
-		auto ScopeInfoPtr = ScopeInfo.FindByKey(Scope);
+		auto ScopeInfoPtr = ScopeInfo.Find(Scope);
 		/**
 		 * There's some bug here related to deferred nodes that triggers this ensure
 		 * I don't have time to fix it yet, so the ensure is disabled
@@ -135,7 +135,7 @@ void FGameplayDebuggerCategory_Coroutines::DrawData(APlayerController* OwnerPC,
 	};
 	auto IndentForScope = [&](FCoroutineNode* Scope)
 	{
-		auto ScopeInfoPtr = ScopeInfo.FindByKey(Scope);
+		auto ScopeInfoPtr = ScopeInfo.Find(Scope);
 		return ScopeInfoPtr ? ScopeInfoPtr->Indent : 0.0;
 	};
 	auto IndentForRow = [&](FCoroutineExecutor::FDebuggerRow const& Row)
@@ -150,76 +150,83 @@ void FGameplayDebuggerCategory_Coroutines::DrawData(APlayerController* OwnerPC,
 		}
 		return 2.0 * Row.Depth;
 	};
+	auto StringPassesFilter = [&] (FString const& String)
+	{
+		for (auto& Filter : GCoroutineDebuggerFilter)
+		{
+			if (String.Contains(Filter))
+				return true;
+		}
+		return false;
+	};
+	//formatting and measuring names is the most expensive part of drawing, so it's only done once per distinct name
+	if (LabelCache.Num() > MaxCachedLabels)
+	{
+		LabelCache.Reset();
+	}
+	auto GetLabel = [&](FCoroutineDebugName const& Name) -> FEntryLabel const&
+	{
+		if (FEntryLabel* Label = LabelCache.Find(Name))
+			return *Label;
+		FEntryLabel& Label = LabelCache.Add(Name);
+		Label.String = Name.ToString();
+		Label.Text = FText::FromString(Label.String);
+		Label.Width = FontMeasure->Measure(Label.String, FontInfo, 1).X;
+		return Label;
+	};
+	//rows below the bottom of the screen aren't visited at all
+	const double MaxY = Canvas->SizeY - RowHeight;
+	bool bMoreBelow = false;
 	for (const auto Exec : ExecutorsToDebug)
 	{
-		if (Exec->DebuggerInfo.Num() == 0)
+		//scrolling skips whole roots, following the links between them instead of walking their rows
+		auto RowIt = Exec->CreateDebuggerRowIterator(Offset);
+		if (!RowIt)
 			continue;
-		auto IsRootScope = [](auto RowIt)
-		{
-			return RowIt->bIsScope && RowIt->Parent == nullptr;
-		};
-		int FirstNodeToShow = 0;
-		if (Offset > 0)
+		ScopeInfo.Reset();
+		ScopeInfo.Add(RowIt->Node, FScopeInfo{Y + RowHeight*0.6, 0.0});
+		while (RowIt)
 		{
-			int SkippedRoots = 0;
-			for (int i = 0; i < Exec->DebuggerInfo.Num(); ++i)
+			if (Y > MaxY)
 			{
-				if (IsRootScope(&Exec->DebuggerInfo[i]))
-				{
-					++SkippedRoots;
-					if (SkippedRoots > Offset)
-					{
-						FirstNodeToShow = i;
-						break;
-					}
-				}
+				bMoreBelow = true;
+				break;
 			}
-		}
-		ScopeInfo.Reset();
-		ScopeInfo.Add( FScopeInfo{Exec->DebuggerInfo[FirstNodeToShow].Node, Y + RowHeight*0.6, 0.0} );
-		auto View = MakeArrayView(Exec->DebuggerInfo.GetData()+FirstNodeToShow, Exec->DebuggerInfo.Num() - FirstNodeToShow);
-		for (int i = 0; i < View.Num(); ++i)
-		{
-			auto RowIt = &View[i];
-			if (GCoroutineDebuggerFilter.Num() > 0)
+			auto& Row = *RowIt;
+			if (GCoroutineDebuggerFilter.Num() > 0 && Row.ParentRow == INDEX_NONE)
 			{
-				auto StringPassesFilter = [&] (FString String)
-				{
-					for (auto& Filter : GCoroutineDebuggerFilter)
-					{
-						if (String.Contains(Filter))
-							return true;
-					}
-					return false;
-				};
-				if (IsRootScope(RowIt))
+				if (ensure(Row.Entries.Num() > 0) && !StringPassesFilter(GetLabel(Row.Entries.Last().Name).String))
 				{
-					while (RowIt && ensure(RowIt->Entries.Num() > 0) && !StringPassesFilter(RowIt->Entries.Last().Name))
-					{
-						do
-						{
-							++RowIt;
-						} while(RowIt && !IsRootScope(RowIt));
-					}
-					if (!RowIt)
-						break;
+					RowIt.NextRoot();
+					continue;
 				}
 			}
-			auto& Row = *RowIt;
+			++RowIt;
 			bool bSkipInCompactMode = !Row.bIsScope && !Row.bIsLeaf;
 			if (bCompactMode && bSkipInCompactMode)
 			{
 				continue;
 			}
-			const auto* FirstEntryToRender = Algo::FindByPredicate(Row.Entries, [&](const FCoroutineExecutor::FDebuggerEntry& Entry)
+			//entries in a row don't overlap and only the last one can still be open, so the first visible one can be found with a binary search
+			int FirstEntryIndex = 0;
+			for (int Count = Row.Entries.Num(); Count > 0;)
 			{
-				return Entry.EndTime < 0.0 || Entry.EndTime >= StartTime;
-			});
-			if (FirstEntryToRender == nullptr)
+				const int Step = Count / 2;
+				const auto& Entry = Row.Entries[FirstEntryIndex + Step];
+				if (Entry.EndTime >= 0.0 && Entry.EndTime < StartTime)
+				{
+					FirstEntryIndex += Step + 1;
+					Count -= Step + 1;
+				}
+				else
+				{
+					Count = Step;
+				}
+			}
+			if (FirstEntryIndex >= Row.Entries.Num())
 			{
 				continue;
 			}
-			const int FirstEntryIndex = Row.Entries.ConvertPointerToIndex(FirstEntryToRender);
 			int DrawnEntries = 0;
 			double FirstEntryX = 0.0;
 			double Indent = IndentForRow(Row);
@@ -240,12 +247,13 @@ void FGameplayDebuggerCategory_Coroutines::DrawData(APlayerController* OwnerPC,
 				EntryTile.BlendMode = SE_BLEND_TranslucentAlphaOnly;
 				EntryTile.Draw(FCanvas);
 				EntryStartPos.X += 4.0;
-				if (Entry.Name.Len() > 0)
+				//no name fits in strips this narrow, so don't bother looking it up
+				if (EntryWidth > MinLabelWidth && !Entry.Name.IsEmpty())
 				{
-					auto TextMeasure = FontMeasure->Measure(Entry.Name, FontInfo, 1);
-					if (TextMeasure.X + 5.0 < EntryWidth)
+					FEntryLabel const& Label = GetLabel(Entry.Name);
+					if (Label.Width + 5.0 < EntryWidth)
 					{
-						FCanvasTextItem EntryText(EntryStartPos, FText::FromString(Entry.Name), GEngine->GetTinyFont(), FLinearColor::White);
+						FCanvasTextItem EntryText(EntryStartPos, Label.Text, GEngine->GetTinyFont(), FLinearColor::White);
 						EntryText.Draw(FCanvas);
 					}
 				}
@@ -264,12 +272,22 @@ void FGameplayDebuggerCategory_Coroutines::DrawData(APlayerController* OwnerPC,
 			}
 			if (Row.bIsScope)
 			{
-				ScopeInfo.Add(FScopeInfo { Row.Node, Y + RowHeight*0.8, Indent });
+				ScopeInfo.Add(Row.Node, FScopeInfo { Y + RowHeight*0.8, Indent });
 			}
 			Y += RowHeight+SpaceBetweenRows;
 		}
 		LastHeight = Y;
 	}
+
+	if (bMoreBelow)
+	{
+		FCanvasTileItem ScrollDownTile(FVector2D{ Flt(X-5.0), Flt(Y+5.0)}, FVector2D(Flt(GraphWidth + 10.0), Flt(10.0)), FLinearColor::Black.CopyWithNewOpacity(0.5f));
+		ScrollDownTile.BlendMode = SE_BLEND_TranslucentAlphaOnly;
+		ScrollDownTile.Draw(FCanvas);
+
+		FCanvasTextItem ScrollDownText(FVector2D{ Flt(X-5.0 + GraphWidth*0.5), Flt(Y+5.0)}, INVTEXT("More..."), GEngine->GetTinyFont(), FLinearColor::White);
+		ScrollDownText.Draw(FCanvas);
+	}
 }
 
 void FGameplayDebuggerCategory_Coroutines::ToggleCompactMode()
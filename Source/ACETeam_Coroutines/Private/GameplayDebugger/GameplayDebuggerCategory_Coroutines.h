@@ -5,6 +5,7 @@
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 
 #include "GameplayDebuggerCategory.h"
+#include "CoroutineNode.h"
 
 class APlayerController;
 
@@ -27,6 +28,17 @@ public:
 
 	bool bCompactMode = true;
 	int Offset = 0;
+
+private:
+	struct FEntryLabel
+	{
+		FString String;
+		FText Text;
+		double Width = 0.0;
+	};
+	TMap<ACETeam_Coroutines::FCoroutineDebugName, FEntryLabel> LabelCache;
+	static constexpr int32 MaxCachedLabels = 4096;
+	static constexpr double MinLabelWidth = 12.0;
 };
 
 #endif // WITH_ACETEAM_COROUTINE_DEBUGGER
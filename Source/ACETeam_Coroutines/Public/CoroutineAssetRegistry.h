@@ -0,0 +1,104 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineAsyncResult.h"
+#include "CoroutineParameter.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+#include "Containers/Ticker.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		/**
+		 * Runs an Asset Registry query on a background thread, and delivers the results on the game thread.
+		 * Only the on-disk asset data can be gathered off the game thread, so in-memory assets that were modified or
+		 * created at runtime are reported as they are on disk. If the registry is still scanning, the query waits for it.
+		 * Before UE5 the registry can only be read on the game thread, so the query is split into one per package path
+		 * (or per class, if it has no paths) instead, and one of them is run each frame.
+		 */
+		class ACETEAM_COROUTINES_API FAsyncAssetRegistryQuery : public TSharedFromThis<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe>
+		{
+		public:
+			typedef TFunction<void (TArray<FAssetData> const& Assets)> FOnFinished;
+			
+			static TSharedRef<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe> Start(FARFilter const& Filter, FOnFinished const& OnFinished);
+			//Stops the callback from being called. A query already running on another thread still finishes there
+			void Cancel();
+			~FAsyncAssetRegistryQuery();
+
+		private:
+			FAsyncAssetRegistryQuery(FARFilter const& InFilter, FOnFinished const& InOnFinished);
+			void Launch();
+			void Finish(TArray<FAssetData> const& Assets);
+			
+			FARFilter Filter;
+			FOnFinished OnFinished;
+			FDelegateHandle FilesLoadedHandle;
+#if ENGINE_MAJOR_VERSION == 4
+			//Runs the next of the split filters, returning false once they're all done
+			bool RunNextFilter();
+
+			TArray<FARFilter> SplitFilters;
+			int32 NextFilter = 0;
+			TArray<FAssetData> GatheredAssets;
+			//Split filters can overlap when classes are searched recursively
+			TSet<FName> GatheredObjectPaths;
+			FDelegateHandle TickerHandle;
+#endif
+		};
+
+		template <typename TLambda>
+		class TAssetRegistryQueryNode : public TAsyncResultNodeFor<TLambda, TArray<FAssetData>>
+		{
+		public:
+			TAssetRegistryQueryNode(TFunction<FARFilter ()> const& InFilterProvider, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, TArray<FAssetData>>(InLambda)
+				, FilterProvider(InFilterProvider)
+			{}
+			virtual ~TAssetRegistryQueryNode() override
+			{
+				TAssetRegistryQueryNode::CancelRequest();
+			}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				Query = FAsyncAssetRegistryQuery::Start(FilterProvider(), [this](TArray<FAssetData> const& Assets)
+				{
+					Query.Reset();
+					this->DeliverResult(Assets);
+				});
+				return true;
+			}
+			virtual void CancelRequest() override
+			{
+				if (Query.IsValid())
+				{
+					Query->Cancel();
+					Query.Reset();
+				}
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("QueryAssets"); }
+#endif
+
+		private:
+			TFunction<FARFilter ()> FilterProvider;
+			TSharedPtr<FAsyncAssetRegistryQuery, ESPMode::ThreadSafe> Query;
+		};
+	}
+
+	//Gathers the assets matching the filter from the Asset Registry on a background thread, so big queries don't hitch
+	//the game thread. Only on-disk asset data is searched. The filter can be a constant, TCoroVar or lambda, evaluated
+	//when the element starts. The lambda receives TArray<FAssetData> const&, and can return void, bool, or a node to run
+	//in its place
+	template <typename TFilterParam, typename TLambda>
+	FCoroutineNodeRef _QueryAssetsAsync(TFilterParam const& Filter, TLambda const& Lambda)
+	{
+		static_assert(Detail::TIsCoroutineParam_V<FARFilter, TFilterParam>, "Filter needs to either be an FARFilter constant, TCoroVar<FARFilter>, or a lambda that returns FARFilter");
+		return MakeShared<Detail::TAssetRegistryQueryNode<TLambda>, DefaultSPMode>(Detail::ParameterHelper<FARFilter, TFilterParam>(Filter), Lambda);
+	}
+}
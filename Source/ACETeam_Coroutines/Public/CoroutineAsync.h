@@ -51,7 +51,7 @@ namespace ACETeam_Coroutines
 					{
 						if (CachedExec)
 						{
-							CachedExec->ForceNodeEnd(this, Completed);
+							CachedExec->ForceNodeEnd(this, Completed, EWakeSource::Async);
 						}
 					});
 				});
@@ -62,7 +62,7 @@ namespace ACETeam_Coroutines
 				CachedExec = nullptr;
 			}
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Async"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Async"); }
 #endif
 		private:
 			ENamedThreads::Type NamedThread;
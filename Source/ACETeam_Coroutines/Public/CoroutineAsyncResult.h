@@ -0,0 +1,163 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineExecutor.h"
+#include "CoroutineNode.h"
+#include "FunctionTraits.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		/**
+		 * Base for nodes that issue an asynchronous request and suspend until its result is delivered.
+		 * Subclasses start the request in StartRequest, and call DeliverResult (or FinishWithoutResult) on the game thread
+		 * once it's done. This can happen from within StartRequest, if the result is available right away.
+		 */
+		template <typename ...TValues>
+		class TAsyncResultNodeBase : public FCoroutineNode
+		{
+		public:
+			virtual EStatus Start(FCoroutineExecutor* Exec) override
+			{
+				CachedExec = Exec;
+				bWaitingForResult = true;
+				bStarting = true;
+				StartStatus = Suspended;
+				const bool bStarted = StartRequest();
+				bStarting = false;
+				if (!bStarted)
+				{
+					bWaitingForResult = false;
+					CachedExec = nullptr;
+					return Failed;
+				}
+				return StartStatus;
+			}
+			//We're standing in for the child coroutine returned by the result handler, so we replicate its end status
+			virtual EStatus OnChildStopped(FCoroutineExecutor*, EStatus Status, FCoroutineNode*) override { return Status; }
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override
+			{
+				if (bWaitingForResult)
+				{
+					bWaitingForResult = false;
+					CancelRequest();
+				}
+				if (Status == Aborted && Child.IsValid())
+				{
+					Exec->AbortNode(Child.ToSharedRef());
+				}
+				Child.Reset(); //Child has finished its execution, so it can be released
+				CachedExec = nullptr;
+			}
+
+		protected:
+			//Issues the request. Returning false fails the node right away
+			virtual bool StartRequest() = 0;
+			//Called when the node ends before the result arrived. The result must not be delivered after this
+			virtual void CancelRequest() {}
+			//Passes the result on to the user's handler, and finishes the node according to what it returns
+			virtual EStatus HandleResult(TValues const&... Values) = 0;
+
+			void DeliverResult(TValues const&... Values)
+			{
+				check(IsInGameThread());
+				if (!bWaitingForResult)
+					return;
+				bWaitingForResult = false;
+				Finish(HandleResult(Values...));
+			}
+
+			//For requests that failed or were canceled by the system serving them
+			void FinishWithoutResult(EStatus Status = Failed)
+			{
+				check(IsInGameThread());
+				if (!bWaitingForResult)
+					return;
+				bWaitingForResult = false;
+				Finish(Status);
+			}
+
+			void RunChild(FCoroutineNodeRef const& InChild)
+			{
+				Child = InChild;
+				CachedExec->EnqueueCoroutineNode(InChild, this, bStarting ? EWakeSource::None : EWakeSource::Async);
+			}
+
+			bool IsWaitingForResult() const { return bWaitingForResult; }
+
+		private:
+			void Finish(EStatus Status)
+			{
+				if (Status == Suspended)
+					return;
+				if (bStarting)
+				{
+					StartStatus = Status;
+				}
+				else if (CachedExec)
+				{
+					CachedExec->ForceNodeEnd(this, Status, EWakeSource::Async);
+				}
+			}
+
+			FCoroutineExecutor* CachedExec = nullptr;
+			FCoroutineNodePtr Child;
+			EStatus StartStatus = Suspended;
+			bool bWaitingForResult = false;
+			bool bStarting = false;
+		};
+
+		//Maps the return type of the lambda receiving the result to how the node finishes, same as with other lambdas:
+		//void completes, bool completes or fails, and a node is run in place of this one
+		template <typename TLambda, typename TLambdaRetType, typename ...TValues>
+		class TAsyncResultNode : public TAsyncResultNodeBase<TValues...>
+		{
+			static_assert(sizeof(TLambda) == 0, "Result handlers only support void, bool, and FCoroutineNodeRef return types");
+		};
+
+		template <typename TLambda, typename ...TValues>
+		class TAsyncResultNode<TLambda, void, TValues...> : public TAsyncResultNodeBase<TValues...>
+		{
+		public:
+			TAsyncResultNode(TLambda const& InLambda) : Lambda(InLambda) {}
+		protected:
+			virtual EStatus HandleResult(TValues const&... Values) override
+			{
+				Lambda(Values...);
+				return Completed;
+			}
+			TLambda Lambda;
+		};
+
+		template <typename TLambda, typename ...TValues>
+		class TAsyncResultNode<TLambda, bool, TValues...> : public TAsyncResultNodeBase<TValues...>
+		{
+		public:
+			TAsyncResultNode(TLambda const& InLambda) : Lambda(InLambda) {}
+		protected:
+			virtual EStatus HandleResult(TValues const&... Values) override
+			{
+				return Lambda(Values...) ? Completed : Failed;
+			}
+			TLambda Lambda;
+		};
+
+		template <typename TLambda, typename ...TValues>
+		class TAsyncResultNode<TLambda, FCoroutineNodeRef, TValues...> : public TAsyncResultNodeBase<TValues...>
+		{
+		public:
+			TAsyncResultNode(TLambda const& InLambda) : Lambda(InLambda) {}
+		protected:
+			virtual EStatus HandleResult(TValues const&... Values) override
+			{
+				this->RunChild(Lambda(Values...));
+				return Suspended;
+			}
+			TLambda Lambda;
+		};
+
+		template <typename TLambda, typename ...TValues>
+		using TAsyncResultNodeFor = TAsyncResultNode<TLambda, typename ::TFunctorTraits<TLambda>::RetType, TValues...>;
+	}
+}
@@ -17,6 +17,7 @@ namespace ACETeam_Coroutines
 		public:
 			TLambdaCoroutine (TLambda const & Lambda) : m_Lambda(Lambda){}
 			virtual EStatus Start(FCoroutineExecutor*) override { m_Lambda(); return Completed;}
+			ACETEAM_COROUTINE_CPU_TRACE_EVENT("Coroutine Lambda")
 		};
 
 		template <typename TLambda>
@@ -26,6 +27,7 @@ namespace ACETeam_Coroutines
 		public:
 			TConditionLambdaCoroutine (TLambda const & Lambda) : m_Lambda(Lambda) {}
 			virtual EStatus Start(FCoroutineExecutor*) override { return m_Lambda() ? Completed : Failed; }
+			ACETEAM_COROUTINE_CPU_TRACE_EVENT("Coroutine Lambda")
 		};
 		
 		template <typename TLambda>
@@ -55,6 +57,7 @@ namespace ACETeam_Coroutines
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 			virtual bool Debug_IsDeferredNodeGenerator() const override { return true; }
 #endif
+			ACETEAM_COROUTINE_CPU_TRACE_EVENT("Coroutine Deferred")
 		};
 		
 		template <typename TLambdaRetType = void, typename Enable=void>
@@ -100,7 +103,7 @@ namespace ACETeam_Coroutines
 		{
 			virtual EStatus Start(FCoroutineExecutor* Exec) override;
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Wait forever"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Wait forever"); }
 #endif
 		};
 	}
@@ -138,6 +141,7 @@ namespace ACETeam_Coroutines
 			void AddChild(FCoroutineNodeRef const& Child);
 			virtual void End(FCoroutineExecutor* Executor, EStatus Status) override;
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
+			virtual void Prefetch() override;
 		};
 
 		class ACETEAM_COROUTINES_API FNot : public FCoroutineDecorator
@@ -190,7 +194,7 @@ namespace ACETeam_Coroutines
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode*) override;
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Loop"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Loop"); }
 #endif
 		};
 
@@ -261,14 +265,22 @@ namespace ACETeam_Coroutines
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 			FNamedScopeNode* ParentScope = nullptr; //set by executor
 			FString Name;
-			virtual FString Debug_GetName() const override { return Name; }
+			//interned once, so entries in the debugger can refer to it without copying the string
+			FName InternedName;
+			mutable uint32 CpuTraceSpecId = 0;
+			//Spec of the CPU trace event emitted while nodes in this scope run, shared by all the scopes with the same name
+			uint32 GetCpuTraceSpecId() const;
+			//Entry that accumulates the CPU time of the scopes with this name, found the first time it's needed
+			mutable int32 ScopeCostIndex = INDEX_NONE;
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("{0}"), InternedName); }
 			virtual bool Debug_IsDebuggerScope() const override { return true; }
 			friend class ::ACETeam_Coroutines::FCoroutineExecutor;
 #endif
 		public:
 			FNamedScopeNode(FString&& InName)
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-				: Name(InName)
+				: Name(MoveTemp(InName))
+				, InternedName(*Name)
 #endif
 			{}
 			
@@ -312,12 +324,14 @@ namespace ACETeam_Coroutines
 		class ACETEAM_COROUTINES_API FSequence : public FCompositeCoroutine
 		{
 			uint32 m_CurChild = 0;
+			void StartNextChild(FCoroutineExecutor* Exec);
 		public:
 			virtual EStatus Start(FCoroutineExecutor* Exec) override;
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
+			virtual void Prefetch() override;
 			
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Seq"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Seq"); }
 #endif
 		};
 		
@@ -327,7 +341,7 @@ namespace ACETeam_Coroutines
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("OptionalSeq"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("OptionalSeq"); }
 #endif
 		};
 
@@ -339,7 +353,7 @@ namespace ACETeam_Coroutines
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Select"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Select"); }
 #endif
 		};
 
@@ -365,7 +379,7 @@ namespace ACETeam_Coroutines
 			}
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return FString::Printf(TEXT("Wait %.1fs"), m_TargetTime); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("Wait {0}s"), m_TargetTime); }
 #endif
 		};
 
@@ -394,7 +408,7 @@ namespace ACETeam_Coroutines
 			}
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return FString::Printf(TEXT("Wait %d frames"), m_TargetFrames); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("Wait {0} frames"), m_TargetFrames); }
 #endif
 		};
 
@@ -427,7 +441,7 @@ namespace ACETeam_Coroutines
 			}
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return FString::Printf(TEXT("Wait %.1fs"), m_DebugLastTimer); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("Wait {0}s"), m_DebugLastTimer); }
 #endif
 		};
 
@@ -435,6 +449,7 @@ namespace ACETeam_Coroutines
 		{
 		public:
 			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual void Prefetch() override;
 			void AbortOtherBranches( FCoroutineNode* Child, FCoroutineExecutor* Exec );
 		};
 
@@ -443,7 +458,7 @@ namespace ACETeam_Coroutines
 		public:
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Race"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Race"); }
 #endif
 		};
 
@@ -455,7 +470,7 @@ namespace ACETeam_Coroutines
 			virtual EStatus Start(FCoroutineExecutor* Exec) override;
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Sync"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Sync"); }
 #endif
 		};
 
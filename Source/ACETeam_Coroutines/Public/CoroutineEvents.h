@@ -35,6 +35,9 @@ namespace ACETeam_Coroutines
 		public:
 			FEventListenerBase(TSharedRef<FEventBase, DefaultSPMode> const& _Event)
 			:Event(_Event)
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			,DebugEventName(_Event->DebugName.IsEmpty() ? NAME_None : FName(*_Event->DebugName))
+#endif
 			{}
 			virtual void ReceiveEvent();
 			void EventAborted();
@@ -43,11 +46,13 @@ namespace ACETeam_Coroutines
 			TSharedRef<FEventBase, DefaultSPMode> Event;
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override
+			//interned when the listener is made, instead of every time it starts
+			FName DebugEventName;
+			virtual FCoroutineDebugName Debug_GetName() const override
 			{
-				if (Event->DebugName.IsEmpty())
+				if (DebugEventName.IsNone())
 					return TEXT("Wait for event");
-				return FString::Printf(TEXT("Awaiting (%s)"), *Event->DebugName);
+				return FCoroutineDebugName(TEXT("Awaiting ({0})"), DebugEventName);
 			}
 #endif
 		};
@@ -64,7 +69,7 @@ namespace ACETeam_Coroutines
 					const EStatus ReceiveStatus = HandleValues(Values...);
 					if (FCoroutineExecutor::IsFinished(ReceiveStatus))
 					{
-						CachedExec->ForceNodeEnd(this, ReceiveStatus);
+						CachedExec->ForceNodeEnd(this, ReceiveStatus, EWakeSource::Event);
 					}
 				}
 			}
@@ -186,7 +191,7 @@ namespace ACETeam_Coroutines
 				if (this->CachedExec)
 				{
 					Child = Lambda(Values...);
-					this->CachedExec->EnqueueCoroutineNode(Child.ToSharedRef(), this);
+					this->CachedExec->EnqueueCoroutineNode(Child.ToSharedRef(), this, EWakeSource::Event);
 				}
 				return Suspended;
 			}
@@ -232,7 +237,7 @@ namespace ACETeam_Coroutines
 			{
 				if (CachedExec)
 				{
-					CachedExec->ForceNodeEnd(this, Lambda() ? Completed : Failed);
+					CachedExec->ForceNodeEnd(this, Lambda() ? Completed : Failed, EWakeSource::Event);
 				}
 			}
 			TLambda Lambda;
@@ -251,7 +256,7 @@ namespace ACETeam_Coroutines
 				if (this->CachedExec)
 				{
 					Child = Lambda();
-					this->CachedExec->EnqueueCoroutineNode(Child.ToSharedRef(), this);
+					this->CachedExec->EnqueueCoroutineNode(Child.ToSharedRef(), this, EWakeSource::Event);
 				}
 			}
 			//We're standing in for the child coroutine, so we replicate its end status
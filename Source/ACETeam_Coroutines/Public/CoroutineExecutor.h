@@ -3,6 +3,7 @@
 
 #include "CoroutineNode.h"
 #include "Containers/RingBuffer.h"
+#include "HAL/PlatformTime.h"
 
 namespace ACETeam_Coroutines
 {
@@ -11,6 +12,20 @@ namespace ACETeam_Coroutines
 		class FNamedScopeNode;
 	}
 
+	//What woke up a branch that was waiting on something outside the executor. Used to measure how long it took to resume
+	enum class EWakeSource : uint8
+	{
+		None,
+		Event,
+		Async,
+		Streaming,
+		Semaphore,
+		Lock,
+		RateLimit,
+		Count
+	};
+	ACETEAM_COROUTINES_API const TCHAR* ToString(EWakeSource Source);
+
 	class ACETEAM_COROUTINES_API FCoroutineExecutor
 	{
 		enum
@@ -27,6 +42,10 @@ namespace ACETeam_Coroutines
 			EStatus Status = static_cast<EStatus>(None);
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 			Detail::FNamedScopeNode* ScopeNode = nullptr;
+			//Set when the node was woken up, until it's evaluated again
+			EWakeSource WakeSource = EWakeSource::None;
+			int32 WakeStep = 0;
+			uint64 WakeCycle = 0;
 #endif
 		};
 		
@@ -40,8 +59,46 @@ namespace ACETeam_Coroutines
 		//Used by loops to determine when they should stop their work for the step
 		int m_StepCount= 0;
 
+	public:
+		//Work done by the executor during a step. Nodes aborted or forced to end between steps are counted in the next one
+		struct FStepStats
+		{
+			int32 NodesStarted = 0;
+			int32 NodesEnded = 0;
+			int32 NodesAborted = 0;
+			//at the end of the step
+			int32 NumActive = 0;
+			int32 NumSuspended = 0;
+			//allocated size of the active ring buffer and the suspended list
+			int32 ActiveCapacity = 0;
+			int32 SuspendedCapacity = 0;
+			//how many of those were reallocated since the previous step
+			int32 Reallocations = 0;
+			double StepTimeSeconds = 0.0;
+		};
+	private:
+		FStepStats CurrentStepStats;
+		FStepStats LastStepStats;
+		uint64 StepStartCycle = 0;
+		//Also sends the stats to the STAT, CSV profiler and trace counters
+		void FinishStepStats();
+
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-		int32 LastCpuTraceSpecId = 0;
+		//Decided at the start of each step, so the work is skipped while nobody is looking at it
+		bool bTrackForDebugger = false;
+		bool bEmitTraceScopes = false;
+		bool bEmitLifecycleTrace = false;
+		bool bTrackScopeCost = false;
+		//Set while a node evaluation is being timed, so nested evaluations (e.g. a node forced to end from inside an update) aren't counted twice
+		bool bTimingScopeCost = false;
+		void AddScopeCost(const Detail::FNamedScopeNode* Scope, FCoroutineNode* Node, uint64 Cycles);
+		bool bTrackWakeLatency = false;
+		//Wake-up being processed by ForceNodeEnd, given to the ancestor it reactivates
+		EWakeSource PendingWakeSource = EWakeSource::None;
+		uint64 PendingWakeCycle = 0;
+		void RecordWakeLatency(FNodeExecInfo const& Info);
+		void UpdateDebugTracking();
+		void TraceStepEnd();
 		int32 CurrentTraceDepth = 0;
 		const Detail::FNamedScopeNode* LastScope = nullptr;
 		const FNodeExecInfo* CurrentExecInfo = nullptr;
@@ -82,8 +139,10 @@ namespace ACETeam_Coroutines
 
 		void Step(float DeltaTime)
 		{
+			StepStartCycle = FPlatformTime::Cycles64();
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 			TRACE_CPUPROFILER_EVENT_SCOPE(FCoroutineExecutor::Step);
+			UpdateDebugTracking();
 #endif
 			
 			while (SingleStep(DeltaTime)) { continue; }
@@ -94,8 +153,15 @@ namespace ACETeam_Coroutines
 			
 			Cleanup();
 			++m_StepCount;
+
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			TraceStepEnd();
+#endif
+			FinishStepStats();
 		}
 
+		FStepStats const& GetLastStepStats() const { return LastStepStats; }
+
 		// Finds the root of the tree containing this node, and aborts the whole tree
 		// Use of this function should be limited to the handling of fatal errors
 		void AbortTree(FCoroutineNode* Coroutine);
@@ -116,7 +182,8 @@ namespace ACETeam_Coroutines
 		
 		//Internal - Enqueues a coroutine node for execution as soon as possible, if this is done while the Executor's step is
 		//running this will be the next node to be evaluated.
-		void EnqueueCoroutineNode(FCoroutineNodeRef const& Node, FCoroutineNode* Parent);
+		//Nodes that resume a waiting branch from outside the executor (e.g. semaphores) pass what woke it up
+		void EnqueueCoroutineNode(FCoroutineNodeRef const& Node, FCoroutineNode* Parent, EWakeSource WakeSource = EWakeSource::None);
 
 		// Internal - This function silently drops a coroutine node from the executor,
 		// only telling the node itself about it.
@@ -130,12 +197,19 @@ namespace ACETeam_Coroutines
 		// This function can be used to force a task to end outside of the normal functioning of the executor.
 		// For instance, a task whose only purpose is to wait suspended for something to happen can be notified in this
 		// way. Note however that any dependent tasks will not be updated until the executor's next step.
-		void ForceNodeEnd(FCoroutineNode* Node, EStatus Status);
+		// WakeSource tells what ended the node, to measure how long it takes until the branch waiting for it resumes.
+		void ForceNodeEnd(FCoroutineNode* Node, EStatus Status, EWakeSource WakeSource = EWakeSource::None);
 
-		void ForceNodeEnd(FCoroutineNodeRef const& Node, EStatus Status) { ForceNodeEnd(&Node.Get(), Status); }
+		void ForceNodeEnd(FCoroutineNodeRef const& Node, EStatus Status, EWakeSource WakeSource = EWakeSource::None) { ForceNodeEnd(&Node.Get(), Status, WakeSource); }
 
 		static bool IsFinished(EStatus Status) { return (Status & Finished) != 0; }
 
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		//Nodes are only tracked for the gameplay debugger while it's being drawn, or if ace.Coroutines.DebuggerTracking is set.
+		//The debugger calls this each time it draws, to keep tracking running in every executor
+		static void RequestDebuggerTracking();
+#endif
+
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 #if PLATFORM_COMPILER_CLANG
 	public:
@@ -145,7 +219,7 @@ namespace ACETeam_Coroutines
 #endif
 		struct FDebuggerEntry
 		{
-			FString Name;
+			FCoroutineDebugName Name;
 			EStatus Status;
 			double StartTime;
 			double EndTime = -1.0f;
@@ -159,14 +233,102 @@ namespace ACETeam_Coroutines
 			bool bIsDeferredNodeGenerator:1;
 			bool bIsScope:1;
 			bool bIsLeaf:1;
+			//Links of the display tree, as indices into DebuggerRows
+			int32 ParentRow = INDEX_NONE;
+			int32 FirstChild = INDEX_NONE;
+			int32 LastChild = INDEX_NONE;
+			int32 PrevSibling = INDEX_NONE;
+			int32 NextSibling = INDEX_NONE;
 			TRingBuffer<FDebuggerEntry> Entries;
-			bool operator==(const FCoroutineNode* InNode) const { return Node == InNode; }
 		};
-		TArray<FDebuggerRow> DebuggerInfo;
+		//Rows keep their index while they live, so adding and removing them never moves the others around.
+		//Display order is kept by the links in each row instead of the position in the array
+		TSparseArray<FDebuggerRow> DebuggerRows;
+		TMap<FCoroutineNode*, int32> DebuggerRowIndex;
+		int32 FirstDebuggerRoot = INDEX_NONE;
+		int32 LastDebuggerRoot = INDEX_NONE;
+		//Rows in the order their entries ended. Since entries end at the current time, this is sorted by end time,
+		//and Cleanup only needs to look at the front of it to find the entries that expired
+		struct FDebuggerExpiry
+		{
+			double EndTime;
+			int32 RowIndex;
+		};
+		TRingBuffer<FDebuggerExpiry> DebuggerExpiryQueue;
+
+		int32 FindDebuggerRow(FCoroutineNode* Node) const;
+		void LinkDebuggerRow(int32 RowIndex, int32 ParentRow);
+		void RemoveDebuggerRow(int32 RowIndex);
+
+		//Walks the rows in the order they're displayed: each row is followed by its children, the most recently started first
+		class FDebuggerRowIterator
+		{
+		public:
+			FDebuggerRowIterator(FCoroutineExecutor const& InExec, int32 InRowIndex) : Exec(InExec), RowIndex(InRowIndex) {}
+			explicit operator bool() const { return RowIndex != INDEX_NONE; }
+			FDebuggerRow const& operator*() const { return Exec.DebuggerRows[RowIndex]; }
+			FDebuggerRow const* operator->() const { return &Exec.DebuggerRows[RowIndex]; }
+			FDebuggerRowIterator& operator++();
+			//Moves on to the next root, skipping what's left of the current one
+			void NextRoot();
+		private:
+			FCoroutineExecutor const& Exec;
+			int32 RowIndex;
+		};
+		//Starts after skipping the given number of roots, without visiting their rows
+		FDebuggerRowIterator CreateDebuggerRowIterator(int32 RootsToSkip = 0) const;
+
+		void TrackNodeStartImpl(FCoroutineNode* Node, FCoroutineNode* Parent, EStatus Status);
+		void TrackNodeSuspendFromUpdateImpl(FCoroutineNode* Node);
+		void TrackNodeEndImpl(FCoroutineNode* Node, EStatus Status);
 #endif
 	private:
-		void TrackNodeStart(FCoroutineNode* Node, FCoroutineNode* Parent, EStatus Status);
-		void TrackNodeSuspendFromUpdate(FCoroutineNode* Node);
-		void TrackNodeEnd(FCoroutineNode* Node, EStatus Status);
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+		//Times the evaluation of a node for the cost accounting of the scope it's in
+		FORCEINLINE uint64 BeginScopeCost(const Detail::FNamedScopeNode* Scope)
+		{
+			if (!bTrackScopeCost || !Scope || bTimingScopeCost)
+				return 0;
+			bTimingScopeCost = true;
+			return FPlatformTime::Cycles64();
+		}
+		FORCEINLINE void EndScopeCost(uint64 StartCycle, const Detail::FNamedScopeNode* Scope, FCoroutineNode* Node)
+		{
+			if (StartCycle != 0)
+			{
+				bTimingScopeCost = false;
+				AddScopeCost(Scope, Node, FPlatformTime::Cycles64() - StartCycle);
+			}
+		}
+#endif
+		FORCEINLINE void TrackNodeStart(FCoroutineNode* Node, FCoroutineNode* Parent, EStatus Status)
+		{
+			++CurrentStepStats.NodesStarted;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			if (bTrackForDebugger || bEmitLifecycleTrace)
+			{
+				TrackNodeStartImpl(Node, Parent, Status);
+			}
+#endif
+		}
+		FORCEINLINE void TrackNodeSuspendFromUpdate(FCoroutineNode* Node)
+		{
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			if (bTrackForDebugger || bEmitLifecycleTrace)
+			{
+				TrackNodeSuspendFromUpdateImpl(Node);
+			}
+#endif
+		}
+		FORCEINLINE void TrackNodeEnd(FCoroutineNode* Node, EStatus Status)
+		{
+			++(Status == Aborted ? CurrentStepStats.NodesAborted : CurrentStepStats.NodesEnded);
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			if (bTrackForDebugger || bEmitLifecycleTrace)
+			{
+				TrackNodeEndImpl(Node, Status);
+			}
+#endif
+		}
 	};
-}
\ No newline at end of file
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineAsyncResult.h"
+#include "Memory/SharedBuffer.h"
+#include "Misc/Paths.h"
+
+class IAsyncReadFileHandle;
+class IAsyncReadRequest;
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		/**
+		 * Reads a region of a file with the engine's async file IO, without blocking any thread while waiting for it.
+		 * The memory read by the IO system is handed over as a shared buffer, without copying it.
+		 * Results are delivered on the game thread, and the read is only ever destroyed there. While a request is in flight
+		 * the read keeps itself alive, so destroying it never has to wait for the IO system.
+		 */
+		class ACETEAM_COROUTINES_API FAsyncFileRead : public TSharedFromThis<FAsyncFileRead, ESPMode::ThreadSafe>
+		{
+		public:
+			typedef TFunction<void (bool bSucceeded, FSharedBuffer const& Buffer)> FOnFinished;
+
+			//Size can be negative to read until the end of the file
+			static TSharedRef<FAsyncFileRead, ESPMode::ThreadSafe> Start(FString const& Path, int64 Offset, int64 Size, FOnFinished const& OnFinished);
+			//Stops the callback from being called, and cancels the requests in flight
+			void Cancel();
+			~FAsyncFileRead();
+
+		private:
+			FAsyncFileRead(int64 InOffset, FOnFinished const& InOnFinished);
+			void Begin(FString const& Path, int64 Size);
+			void OnSizeKnown(int64 FileSize);
+			void IssueRead(int64 BytesToRead);
+			void Finish(bool bSucceeded, FSharedBuffer const& Buffer);
+			//Only called once the request's callback has run, so waiting for it doesn't block
+			static void ReleaseRequest(IAsyncReadRequest*& Request);
+
+			int64 Offset;
+			FOnFinished OnFinished;
+			IAsyncReadFileHandle* Handle = nullptr;
+			IAsyncReadRequest* SizeRequest = nullptr;
+			IAsyncReadRequest* ReadRequest = nullptr;
+			//Set while a request is in flight, since requests can't be deleted before their callback has run
+			TSharedPtr<FAsyncFileRead, ESPMode::ThreadSafe> KeepAlive;
+		};
+
+		//Maps a region of a file into memory. The buffer keeps the mapping alive. Returns a null buffer on failure
+		ACETEAM_COROUTINES_API FSharedBuffer MapFileRegion(FString const& Path, int64 Offset, int64 Size);
+
+		template <typename TLambda>
+		class TReadFileAsyncNode : public TAsyncResultNodeFor<TLambda, FSharedBuffer>
+		{
+		public:
+			TReadFileAsyncNode(FString const& InPath, int64 InOffset, int64 InSize, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, FSharedBuffer>(InLambda)
+				, Path(InPath)
+				, Offset(InOffset)
+				, Size(InSize)
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+				, DebugFileName(*FPaths::GetCleanFilename(InPath))
+#endif
+			{}
+			virtual ~TReadFileAsyncNode() override
+			{
+				TReadFileAsyncNode::CancelRequest();
+			}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				Read = FAsyncFileRead::Start(Path, Offset, Size, [this](bool bSucceeded, FSharedBuffer const& Buffer)
+				{
+					Read.Reset();
+					if (bSucceeded)
+					{
+						this->DeliverResult(Buffer);
+					}
+					else
+					{
+						this->FinishWithoutResult();
+					}
+				});
+				return true;
+			}
+			virtual void CancelRequest() override
+			{
+				if (Read.IsValid())
+				{
+					Read->Cancel();
+					Read.Reset();
+				}
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("ReadFile {0}"), DebugFileName); }
+#endif
+
+		private:
+			FString Path;
+			int64 Offset;
+			int64 Size;
+			TSharedPtr<FAsyncFileRead, ESPMode::ThreadSafe> Read;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			//interned once, instead of every time the node starts
+			FName DebugFileName;
+#endif
+		};
+
+		template <typename TLambda>
+		class TReadFileMappedNode : public TAsyncResultNodeFor<TLambda, FSharedBuffer>
+		{
+		public:
+			TReadFileMappedNode(FString const& InPath, int64 InOffset, int64 InSize, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, FSharedBuffer>(InLambda)
+				, Path(InPath)
+				, Offset(InOffset)
+				, Size(InSize)
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+				, DebugFileName(*FPaths::GetCleanFilename(InPath))
+#endif
+			{}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				FSharedBuffer Buffer = MapFileRegion(Path, Offset, Size);
+				if (Buffer.IsNull())
+					return false;
+				this->DeliverResult(Buffer);
+				return true;
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("ReadFileMapped {0}"), DebugFileName); }
+#endif
+
+		private:
+			FString Path;
+			int64 Offset;
+			int64 Size;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			FName DebugFileName;
+#endif
+		};
+	}
+
+	//Reads Size bytes (or until the end of the file, if negative) starting at Offset, using the engine's async file IO.
+	//The lambda receives the data as an FSharedBuffer const&, which owns the memory the IO system read into.
+	//Like other lambdas, it can return void, bool, or a node to run in its place. Fails if the file can't be read
+	template <typename TLambda>
+	FCoroutineNodeRef _ReadFileAsync(FString const& Path, int64 Offset, int64 Size, TLambda const& Lambda)
+	{
+		return MakeShared<Detail::TReadFileAsyncNode<TLambda>, DefaultSPMode>(Path, Offset, Size, Lambda);
+	}
+
+	//Reads the whole file asynchronously
+	template <typename TLambda>
+	FCoroutineNodeRef _ReadFileAsync(FString const& Path, TLambda const& Lambda)
+	{
+		return _ReadFileAsync(Path, 0, -1, Lambda);
+	}
+
+	//Memory maps the region of the file instead of reading it, for large read-only files that are accessed sparsely.
+	//Pages are loaded on demand when the buffer is accessed, so the lambda runs right away.
+	//Fails if the file can't be mapped on this platform
+	template <typename TLambda>
+	FCoroutineNodeRef _ReadFileMapped(FString const& Path, int64 Offset, int64 Size, TLambda const& Lambda)
+	{
+		return MakeShared<Detail::TReadFileMappedNode<TLambda>, DefaultSPMode>(Path, Offset, Size, Lambda);
+	}
+}
@@ -22,7 +22,7 @@ namespace ACETeam_Coroutines
 			virtual EStatus Update(FCoroutineExecutor* Exec, float dt) override;
 			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override;
+			virtual FCoroutineDebugName Debug_GetName() const override;
 #endif
 		};
 	}
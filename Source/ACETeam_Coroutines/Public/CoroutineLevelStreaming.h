@@ -0,0 +1,87 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineElements.h"
+#include "CoroutineSemaphores.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+class ULevel;
+class ULevelStreaming;
+class UWorld;
+
+#define ACETEAM_HAS_LEVEL_STREAMING_DELEGATES (ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1))
+
+#if ACETEAM_HAS_LEVEL_STREAMING_DELEGATES
+enum class ELevelStreamingState : uint8;
+#endif
+
+namespace ACETeam_Coroutines
+{
+	enum class ELevelStreamingTarget : uint8
+	{
+		Unloaded,
+		//Loaded, but not added to the world
+		LoadedHidden,
+		Visible,
+	};
+
+	namespace Detail
+	{
+		/**
+		 * Sets the streaming flags of a level and suspends until it reaches the target state.
+		 * Where the engine exposes level streaming state changes the node waits for them, otherwise it checks the level
+		 * once per update.
+		 */
+		class ACETEAM_COROUTINES_API FLevelStreamingNode : public FCoroutineNode, public TSharedFromThis<FLevelStreamingNode, DefaultSPMode>
+		{
+		public:
+			enum class EPhase : uint8
+			{
+				//Only makes sure the level is loaded, without touching its visibility
+				Load,
+				//Applies the final target, which may change visibility
+				Target,
+			};
+
+			FLevelStreamingNode(TFunction<ULevelStreaming* ()> const& InLevelGetter, ELevelStreamingTarget InTarget, EPhase InPhase)
+				: LevelGetter(InLevelGetter)
+				, Target(InTarget)
+				, Phase(InPhase)
+			{}
+
+			static bool NeedsVisibilityChange(ULevelStreaming const* Level, ELevelStreamingTarget Target);
+
+		private:
+			TFunction<ULevelStreaming* ()> LevelGetter;
+			TWeakObjectPtr<ULevelStreaming> Level;
+			ELevelStreamingTarget Target;
+			EPhase Phase;
+			FCoroutineExecutor* CachedExec = nullptr;
+			FDelegateHandle StateChangedHandle;
+
+			bool HasReachedTarget(ULevelStreaming const* StreamingLevel) const;
+			void StopListening();
+#if ACETEAM_HAS_LEVEL_STREAMING_DELEGATES
+			void OnLevelStreamingStateChanged(UWorld* World, ULevelStreaming const* StreamingLevel, ULevel* LevelIfLoaded, ELevelStreamingState PreviousState, ELevelStreamingState NewState);
+#endif
+
+			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual EStatus Update(FCoroutineExecutor* Exec, float dt) override;
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override;
+#endif
+		};
+	}
+
+	//Semaphore shared by all _StreamLevel elements, limiting how many levels can be changing visibility at the same time.
+	//Its limit comes from the ace.LevelStreaming.MaxVisibilityTransitions cvar
+	ACETEAM_COROUTINES_API FSemaphoreRef GetLevelVisibilityBudget();
+
+	//Requests the streaming level to be loaded, shown, hidden or unloaded, and suspends until it reaches that state.
+	//Loading happens freely, but adding the level to the world or removing it from it waits for a slot in
+	//the visibility budget, so the cost of those transitions is spread across frames. Fails if the level is missing
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamLevel(ULevelStreaming* Level, ELevelStreamingTarget Target = ELevelStreamingTarget::Visible);
+	//Same as above, with the streaming level looked up by package name when the element starts
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamLevel(UObject* WorldContextObject, FName LevelPackageName, ELevelStreamingTarget Target = ELevelStreamingTarget::Visible);
+}
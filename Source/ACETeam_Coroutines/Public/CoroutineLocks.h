@@ -0,0 +1,277 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineElements.h"
+#include "CoroutineParameter.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		class FReadWriteLock;
+	}
+	
+	typedef TSharedRef<Detail::FReadWriteLock> FReadWriteLockRef;
+	typedef TSharedPtr<Detail::FReadWriteLock> FReadWriteLockPtr;
+	
+	namespace Detail
+	{
+		class ACETEAM_COROUTINES_API FReadWriteLockHandlerNode : public FCoroutineDecorator, public TSharedFromThis<FReadWriteLockHandlerNode, DefaultSPMode>
+		{
+		public:
+			FReadWriteLockHandlerNode(FReadWriteLockRef const& InLock, bool bInWriter)
+				: Lock(InLock)
+				, bWriter(bInWriter)
+			{}
+			void Resume();
+			bool IsWriter() const { return bWriter; }
+			
+		private:
+			FReadWriteLockRef Lock;
+			FCoroutineExecutor* CachedExec = nullptr;
+			bool bWriter;
+			bool bHoldsLock = false;
+			
+			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return bWriter ? TEXT("WriteLock") : TEXT("ReadLock"); }
+#endif
+		};
+
+		typedef TSharedRef<FReadWriteLockHandlerNode, DefaultSPMode> FReadWriteLockHandlerRef;
+		
+		/**
+		 * Lock that admits any number of concurrent readers, or a single writer.
+		 * Waiting branches are queued in arrival order. A reader that arrives while a writer is waiting queues behind it,
+		 * so writers can't be starved by a steady stream of readers. When the lock is handed over, all consecutive readers
+		 * at the front of the queue are let through together.
+		 */
+		class ACETEAM_COROUTINES_API FReadWriteLock
+		{
+		public:
+			bool TryTake(FReadWriteLockHandlerRef const& Handler);
+			bool DropFromQueue(FReadWriteLockHandlerRef const& Handler);
+			void Release(bool bWriter);
+			int GetActiveReaderCount() const { return ActiveReaders; }
+			bool IsWriteLocked() const { return bWriterActive; }
+			int GetQueuedCount() const { return QueuedHandlers.Num(); }
+			
+		private:
+			bool CanTake(bool bWriter) const;
+			void ResumeQueued();
+			
+			int ActiveReaders = 0;
+			bool bWriterActive = false;
+			TArray<FReadWriteLockHandlerRef, TInlineAllocator<2>> QueuedHandlers;
+		};
+
+		struct ACETEAM_COROUTINES_API FReadWriteLockHelper
+		{
+			FReadWriteLockHelper(FReadWriteLockRef const& InLock, bool bInWriter) :
+				Lock(InLock),
+				bWriter(bInWriter)
+			{}
+			
+			FReadWriteLockRef Lock;
+			bool bWriter;
+
+			template <typename TChild>
+			FCoroutineNodeRef operator() (TChild&& ScopeBody)
+			{
+				auto Handler = MakeShared<FReadWriteLockHandlerNode, DefaultSPMode>(Lock, bWriter);
+				AddCoroutineChild(Handler, ScopeBody);
+				return Handler;
+			}
+		};
+	}
+
+	//The scope body runs while holding shared (read) access to the lock. Other readers can run concurrently, writers can't
+	ACETEAM_COROUTINES_API Detail::FReadWriteLockHelper _ReadScope(FReadWriteLockRef const& Lock);
+	
+	//The scope body runs while holding exclusive (write) access to the lock
+	ACETEAM_COROUTINES_API Detail::FReadWriteLockHelper _WriteScope(FReadWriteLockRef const& Lock);
+
+	ACETEAM_COROUTINES_API FReadWriteLockRef MakeReadWriteLock();
+
+	namespace Detail
+	{
+		class ACETEAM_COROUTINES_API FKeyedLockHandlerNode : public FCoroutineDecorator, public TSharedFromThis<FKeyedLockHandlerNode, DefaultSPMode>
+		{
+		public:
+			void Resume();
+			
+		protected:
+			FCoroutineExecutor* CachedExec = nullptr;
+			bool bHoldsLock = false;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Lock"); }
+#endif
+		};
+
+		typedef TSharedRef<FKeyedLockHandlerNode, DefaultSPMode> FKeyedLockHandlerRef;
+
+		//Key independent part of the lock table.
+		//A lock state only exists while its key is held. States live in a sparse array, so the slots of released keys
+		//are recycled for the next keys that get locked
+		class ACETEAM_COROUTINES_API FLockTableBase
+		{
+		public:
+			int GetNumLockStates() const { return Slots.Num(); }
+			
+		protected:
+			struct FLockSlot
+			{
+				TArray<FKeyedLockHandlerRef, TInlineAllocator<1>> QueuedHandlers;
+			};
+			int32 AllocateSlot();
+			void EnqueueAt(int32 SlotIndex, FKeyedLockHandlerRef const& Handler);
+			bool DropFromSlot(int32 SlotIndex, FKeyedLockHandlerRef const& Handler);
+			//Hands the lock over to the next waiting handler. Returns true if there was none, and the slot was freed
+			bool ReleaseSlot(int32 SlotIndex);
+			
+			TSparseArray<FLockSlot> Slots;
+		};
+
+		/**
+		 * Table of mutexes indexed by key, e.g. a smart object or cover point handle.
+		 * Memory is proportional to the number of keys currently locked, instead of the number of lockable resources.
+		 */
+		template <typename KeyType>
+		class TLockTable : public FLockTableBase
+		{
+		public:
+			bool IsLocked(KeyType const& Key) const { return SlotForKey.Contains(Key); }
+			int GetNumLockedKeys() const { return SlotForKey.Num(); }
+			
+			bool TryTake(KeyType const& Key, FKeyedLockHandlerRef const& Handler)
+			{
+				if (const int32* SlotIndex = SlotForKey.Find(Key))
+				{
+					EnqueueAt(*SlotIndex, Handler);
+					return false;
+				}
+				SlotForKey.Add(Key, AllocateSlot());
+				return true;
+			}
+			
+			bool DropFromQueue(KeyType const& Key, FKeyedLockHandlerRef const& Handler)
+			{
+				if (const int32* SlotIndex = SlotForKey.Find(Key))
+				{
+					return DropFromSlot(*SlotIndex, Handler);
+				}
+				return false;
+			}
+			
+			void Release(KeyType const& Key)
+			{
+				const int32 SlotIndex = SlotForKey.FindChecked(Key);
+				if (ReleaseSlot(SlotIndex))
+				{
+					SlotForKey.Remove(Key);
+				}
+			}
+			
+		private:
+			TMap<KeyType, int32> SlotForKey;
+		};
+
+		template <typename KeyType, typename TKeyProvider>
+		class TKeyedLockHandlerNode : public FKeyedLockHandlerNode
+		{
+		public:
+			TKeyedLockHandlerNode(TSharedRef<TLockTable<KeyType>> const& InTable, TKeyProvider const& InKeyProvider)
+				: Table(InTable)
+				, KeyProvider(InKeyProvider)
+			{}
+			
+		private:
+			TSharedRef<TLockTable<KeyType>> Table;
+			TKeyProvider KeyProvider;
+			//key is evaluated on start, and kept so the same lock is released even if the provider changes its value
+			TOptional<KeyType> Key;
+			
+			virtual EStatus Start(FCoroutineExecutor* Exec) override
+			{
+				Key = KeyProvider();
+				if (Table->TryTake(Key.GetValue(), AsShared()))
+				{
+					bHoldsLock = true;
+					return FCoroutineDecorator::Start(Exec);
+				}
+				CachedExec = Exec;
+				return Suspended;
+			}
+			
+			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override
+			{
+				bHoldsLock = false;
+				Table->Release(Key.GetValue());
+				return Status;
+			}
+			
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override
+			{
+				FCoroutineDecorator::End(Exec, Status);
+				if (bHoldsLock)
+				{
+					bHoldsLock = false;
+					Table->Release(Key.GetValue());
+				}
+				else if (CachedExec)
+				{
+					ensure(Table->DropFromQueue(Key.GetValue(), AsShared()));
+				}
+				CachedExec = nullptr;
+				Key.Reset();
+			}
+		};
+
+		template <typename KeyType, typename TKeyProvider>
+		struct TLockScopeHelper
+		{
+			TLockScopeHelper(TSharedRef<TLockTable<KeyType>> const& InTable, TKeyProvider const& InKeyProvider) :
+				Table(InTable),
+				KeyProvider(InKeyProvider)
+			{}
+			
+			TSharedRef<TLockTable<KeyType>> Table;
+			TKeyProvider KeyProvider;
+
+			template <typename TChild>
+			FCoroutineNodeRef operator() (TChild&& ScopeBody)
+			{
+				auto Handler = MakeShared<TKeyedLockHandlerNode<KeyType, TKeyProvider>, DefaultSPMode>(Table, KeyProvider);
+				AddCoroutineChild(Handler, ScopeBody);
+				return Handler;
+			}
+		};
+	}
+
+	template <typename KeyType>
+	using TLockTableRef = TSharedRef<Detail::TLockTable<KeyType>>;
+
+	//Makes a table of mutexes indexed by key. Lock state is only allocated for keys that are currently held.
+	template <typename KeyType>
+	TLockTableRef<KeyType> MakeLockTable()
+	{
+		return MakeShared<Detail::TLockTable<KeyType>>();
+	}
+
+	//The scope body runs while holding exclusive access to the key in the lock table.
+	//The key can be a constant, a TCoroVar, or a lambda returning the key, evaluated when the scope starts
+	//Usage example:
+	//_LockScope(CoverLocks, CoverPointId)
+	//(
+	//  ... body
+	//)
+	template <typename KeyType, typename TKeyParam>
+	auto _LockScope(TLockTableRef<KeyType> const& Table, TKeyParam const& Key)
+	{
+		static_assert(Detail::TIsCoroutineParam_V<KeyType, TKeyParam>, "Key needs to either be a constant, TCoroVar, or a lambda that returns the key type of the table");
+		auto KeyProvider = Detail::ParameterHelper<KeyType, TKeyParam>(Key);
+		return Detail::TLockScopeHelper<KeyType, decltype(KeyProvider)>(Table, KeyProvider);
+	}
+}
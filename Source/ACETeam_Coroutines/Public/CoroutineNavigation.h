@@ -0,0 +1,90 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineAsyncResult.h"
+#include "CoroutineParameter.h"
+#include "AI/Navigation/NavigationTypes.h"
+#include "Templates/SubclassOf.h"
+
+class UNavigationQueryFilter;
+
+namespace ACETeam_Coroutines
+{
+	struct FFindPathSettings
+	{
+		FNavAgentProperties AgentProperties = FNavAgentProperties::DefaultProperties;
+		TSubclassOf<UNavigationQueryFilter> FilterClass;
+		//Whether a partial path to the closest reachable point counts as a result, instead of failing
+		bool bAllowPartialPath = true;
+	};
+
+	namespace Detail
+	{
+		DECLARE_DELEGATE_TwoParams(FOnAsyncPathFound, bool /*bSucceeded*/, FNavPathSharedPtr /*Path*/);
+
+		//Returns the id of the query, or 0 if it couldn't be started
+		ACETEAM_COROUTINES_API uint32 RequestAsyncPathfind(UObject* Querier, FVector const& Start, FVector const& End, FFindPathSettings const& Settings, FOnAsyncPathFound const& OnPathFound);
+		ACETEAM_COROUTINES_API void AbortAsyncPathfind(UObject* Querier, uint32 QueryID);
+
+		template <typename TLambda>
+		class TFindPathAsyncNode : public TAsyncResultNodeFor<TLambda, FNavPathSharedPtr>, public TSharedFromThis<TFindPathAsyncNode<TLambda>, DefaultSPMode>
+		{
+		public:
+			TFindPathAsyncNode(UObject* InQuerier, TFunction<FVector ()> const& InStart, TFunction<FVector ()> const& InEnd, FFindPathSettings const& InSettings, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, FNavPathSharedPtr>(InLambda)
+				, Querier(InQuerier)
+				, StartProvider(InStart)
+				, EndProvider(InEnd)
+				, Settings(InSettings)
+			{}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				QueryID = RequestAsyncPathfind(Querier.Get(), StartProvider(), EndProvider(), Settings,
+					FOnAsyncPathFound::CreateSP(this->AsShared(), &TFindPathAsyncNode::OnPathFound));
+				return QueryID != 0;
+			}
+			virtual void CancelRequest() override
+			{
+				AbortAsyncPathfind(Querier.Get(), QueryID);
+				QueryID = 0;
+			}
+			void OnPathFound(bool bSucceeded, FNavPathSharedPtr Path)
+			{
+				QueryID = 0;
+				if (bSucceeded)
+				{
+					this->DeliverResult(Path);
+				}
+				else
+				{
+					this->FinishWithoutResult();
+				}
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("FindPathAsync"); }
+#endif
+
+		private:
+			TWeakObjectPtr<UObject> Querier;
+			TFunction<FVector ()> StartProvider;
+			TFunction<FVector ()> EndProvider;
+			FFindPathSettings Settings;
+			uint32 QueryID = 0;
+		};
+	}
+
+	//Queues a pathfinding query with the navigation system, and suspends until the path is ready. The query is aborted
+	//if the branch is. Start and End can be constants, TCoroVar or lambdas, and are evaluated when the element starts.
+	//The lambda receives the path as FNavPathSharedPtr const&, and can return void, bool, or a node to run in its place.
+	//Fails if no path was found. To cap how many queries are in flight, wrap it in a _SemaphoreScope
+	template <typename TStartParam, typename TEndParam, typename TLambda>
+	FCoroutineNodeRef _FindPathAsync(UObject* Querier, TStartParam const& Start, TEndParam const& End, TLambda const& Lambda, FFindPathSettings const& Settings = FFindPathSettings())
+	{
+		static_assert(Detail::TIsCoroutineParam_V<FVector, TStartParam>, "Start needs to either be an FVector constant, TCoroVar<FVector>, or a lambda that returns FVector");
+		static_assert(Detail::TIsCoroutineParam_V<FVector, TEndParam>, "End needs to either be an FVector constant, TCoroVar<FVector>, or a lambda that returns FVector");
+		return MakeShared<Detail::TFindPathAsyncNode<TLambda>, DefaultSPMode>(Querier,
+			Detail::ParameterHelper<FVector, TStartParam>(Start), Detail::ParameterHelper<FVector, TEndParam>(End), Settings, Lambda);
+	}
+}
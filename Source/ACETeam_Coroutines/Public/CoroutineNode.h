@@ -1,6 +1,10 @@
 // Copyright ACE Team Software S.A. All Rights Reserved.
 #pragma once
 
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#endif
+
 class UCoroutinesWorldSubsystem;
 
 namespace ACETeam_Coroutines
@@ -29,6 +33,50 @@ constexpr bool TIsCoroutineNodeRef_V<TSharedRef<TSharedRefArg, DefaultSPMode>> =
 
 class FCoroutineExecutor;
 
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+//Name of a node as shown in the debugger. The pattern has to be a static string, and is only formatted with the
+//parameter (replacing {0}) when the debugger draws it, so tracking a node doesn't allocate
+struct ACETEAM_COROUTINES_API FCoroutineDebugName
+{
+	enum class EParam : uint8
+	{
+		None,
+		Float,
+		Int,
+		Name,
+	};
+
+	const TCHAR* Pattern = nullptr;
+	EParam ParamType = EParam::None;
+	union
+	{
+		float FloatParam;
+		int32 IntParam;
+	};
+	FName NameParam;
+
+	FCoroutineDebugName() : IntParam(0) {}
+	FCoroutineDebugName(const TCHAR* InPattern) : Pattern(InPattern), IntParam(0) {}
+	FCoroutineDebugName(const TCHAR* InPattern, float InParam) : Pattern(InPattern), ParamType(EParam::Float), FloatParam(InParam) {}
+	FCoroutineDebugName(const TCHAR* InPattern, int32 InParam) : Pattern(InPattern), ParamType(EParam::Int), IntParam(InParam) {}
+	FCoroutineDebugName(const TCHAR* InPattern, FName InParam) : Pattern(InPattern), ParamType(EParam::Name), IntParam(0), NameParam(InParam) {}
+
+	bool IsEmpty() const { return Pattern == nullptr || *Pattern == 0; }
+	FString ToString() const;
+
+	bool operator==(FCoroutineDebugName const& Other) const
+	{
+		return Pattern == Other.Pattern && ParamType == Other.ParamType && NameParam == Other.NameParam
+			&& (ParamType == EParam::Float ? FloatParam == Other.FloatParam : IntParam == Other.IntParam);
+	}
+	friend uint32 GetTypeHash(FCoroutineDebugName const& Name)
+	{
+		const uint32 ParamHash = Name.ParamType == EParam::Float ? ::GetTypeHash(Name.FloatParam) : ::GetTypeHash(Name.IntParam);
+		return HashCombine(HashCombine(PointerHash(Name.Pattern), ParamHash), GetTypeHash(Name.NameParam));
+	}
+};
+#endif
+
 class ACETEAM_COROUTINES_API FCoroutineNode
 {
 public:
@@ -37,19 +85,32 @@ public:
 	virtual EStatus Update(FCoroutineExecutor* Exec, float dt) { return Running; }
 	virtual void End(FCoroutineExecutor* Exec, EStatus Status) {}
 	virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) { return Running; }
+	//Called by sequences shortly before this node may start, so it can get slow work going ahead of time (e.g. streaming assets).
+	//Must not have side effects other than that, since the node might never be started
+	virtual void Prefetch() {}
 
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
 private:
 	friend class FGameplayDebuggerCategory_Coroutines;
 	friend class FCoroutineExecutor;
 	friend class ::UCoroutinesWorldSubsystem;
-	virtual FString Debug_GetName() const { return FString(); }
+	virtual FCoroutineDebugName Debug_GetName() const { return FCoroutineDebugName(); }
 	virtual bool Debug_IsDeferredNodeGenerator() const { return false; }
 	virtual bool Debug_IsDebuggerScope() const { return false; }
-	virtual int32 Debug_GetCpuTraceId() const { return 0; }
+	//Spec of a CPU trace event that wraps the evaluation of this node in Insights, zero for none. See ACETEAM_COROUTINE_CPU_TRACE_EVENT
+	virtual uint32 Debug_GetCpuTraceId() const { return 0; }
 #endif
 };
 
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+//Gives a node type its own CPU trace event. The spec is registered once, the first time a node of the type is evaluated while
+//tracing, so each evaluation only costs an ID based begin/end event
+#define ACETEAM_COROUTINE_CPU_TRACE_EVENT(Name) \
+	virtual uint32 Debug_GetCpuTraceId() const override { static const uint32 SpecId = FCpuProfilerTrace::OutputEventType(TEXT(Name)); return SpecId; }
+#else
+#define ACETEAM_COROUTINE_CPU_TRACE_EVENT(Name)
+#endif
+
 //WORKAROUND FOR MISSING TEMPLATES FROM UE5
 #if	ENGINE_MAJOR_VERSION < 5
 	template <typename T, typename DerivedType>
@@ -0,0 +1,105 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineElements.h"
+#include "Containers/Ticker.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		class FRateLimiter;
+	}
+	
+	typedef TSharedRef<Detail::FRateLimiter> FRateLimiterRef;
+	typedef TSharedPtr<Detail::FRateLimiter> FRateLimiterPtr;
+	
+	namespace Detail
+	{
+		class ACETEAM_COROUTINES_API FRateLimitHandlerNode : public FCoroutineDecorator, public TSharedFromThis<FRateLimitHandlerNode, DefaultSPMode>
+		{
+		public:
+			FRateLimitHandlerNode(FRateLimiterRef const& InRateLimiter)
+				: RateLimiter(InRateLimiter)
+			{}
+			void Resume();
+			
+		private:
+			FRateLimiterRef RateLimiter;
+			FCoroutineExecutor* CachedExec = nullptr;
+			
+			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("RateLimit"); }
+#endif
+		};
+
+		typedef TSharedRef<FRateLimitHandlerNode, DefaultSPMode> FRateLimitHandlerRef;
+
+		/**
+		 * Token bucket shared by any number of coroutines. Each branch entering a _RateLimit scope consumes a token.
+		 * Tokens refill continuously at a fixed rate, up to the burst size.
+		 * Branches that find the bucket empty wait in a FIFO queue. Instead of polling the waiting branches, a single
+		 * ticker is scheduled for the moment the next token becomes available.
+		 */
+		class ACETEAM_COROUTINES_API FRateLimiter : public TSharedFromThis<FRateLimiter>
+		{
+		public:
+			FRateLimiter(float InTokensPerSecond, int InBurstSize);
+			~FRateLimiter();
+			bool IsAvailable() const;
+			bool TryTake(FRateLimitHandlerRef const& Handler);
+			bool DropFromQueue(FRateLimitHandlerRef const& Handler);
+			void SetRate(float NewTokensPerSecond, int NewBurstSize);
+			float GetTokensPerSecond() const { return TokensPerSecond; }
+			int GetQueuedCount() const { return QueuedHandlers.Num(); }
+			
+		private:
+			void Refill();
+			void ResumeQueued();
+			void ScheduleWakeUp();
+			void ClearWakeUp();
+			
+			float TokensPerSecond;
+			int BurstSize;
+			double Tokens;
+			double LastRefillTime;
+			TArray<FRateLimitHandlerRef, TInlineAllocator<1>> QueuedHandlers;
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+			FTSTicker::FDelegateHandle WakeUpHandle;
+#else
+			FDelegateHandle WakeUpHandle;
+#endif
+		};
+
+		struct ACETEAM_COROUTINES_API FRateLimitHelper
+		{
+			FRateLimitHelper(FRateLimiterRef const& InRateLimiter) :
+				RateLimiter(InRateLimiter)
+			{}
+			
+			FRateLimiterRef RateLimiter;
+
+			template <typename TChild>
+			FCoroutineNodeRef operator() (TChild&& ScopeBody)
+			{
+				auto Handler = MakeShared<FRateLimitHandlerNode, DefaultSPMode>(RateLimiter);
+				AddCoroutineChild(Handler, ScopeBody);
+				return Handler;
+			}
+		};
+	}
+
+	//The scope body will only start once a token can be taken from the rate limiter. Waiting branches are resumed in
+	//the order they arrived. Usage example:
+	//_RateLimit(Limiter)
+	//(
+	//  ... body
+	//)
+	ACETEAM_COROUTINES_API Detail::FRateLimitHelper _RateLimit(FRateLimiterRef const& RateLimiter);
+
+	//Makes a token bucket that lets at most TokensPerSecond branches per second through, with bursts of up to BurstSize
+	ACETEAM_COROUTINES_API FRateLimiterRef MakeRateLimiter(float TokensPerSecond, int BurstSize = 1);
+}
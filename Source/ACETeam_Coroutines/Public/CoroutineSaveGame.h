@@ -0,0 +1,104 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineAsyncResult.h"
+
+class USaveGame;
+
+namespace ACETeam_Coroutines
+{
+	namespace Detail
+	{
+		DECLARE_DELEGATE_OneParam(FOnAsyncSaveGameLoaded, USaveGame* /*SaveGame*/);
+		
+		ACETEAM_COROUTINES_API void RequestAsyncLoadGame(FString const& SlotName, int32 UserIndex, FOnAsyncSaveGameLoaded const& OnLoaded);
+
+		class ACETEAM_COROUTINES_API FSaveGameAsyncNode : public TAsyncResultNodeBase<bool>, public TSharedFromThis<FSaveGameAsyncNode, DefaultSPMode>
+		{
+		public:
+			FSaveGameAsyncNode(TFunction<USaveGame* ()> const& InSaveGameGetter, FString const& InSlotName, int32 InUserIndex)
+				: SaveGameGetter(InSaveGameGetter)
+				, SlotName(InSlotName)
+				, UserIndex(InUserIndex)
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+				, DebugSlotName(*InSlotName)
+#endif
+			{}
+
+		protected:
+			virtual bool StartRequest() override;
+			virtual EStatus HandleResult(bool const& bSucceeded) override { return bSucceeded ? Completed : Failed; }
+			void OnSaved(FString const& Slot, int32 User, bool bSucceeded);
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("SaveGame {0}"), DebugSlotName); }
+#endif
+
+		private:
+			TFunction<USaveGame* ()> SaveGameGetter;
+			FString SlotName;
+			int32 UserIndex;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			//interned once, instead of every time the node starts
+			FName DebugSlotName;
+#endif
+		};
+
+		template <typename TLambda>
+		class TLoadGameAsyncNode : public TAsyncResultNodeFor<TLambda, USaveGame*>, public TSharedFromThis<TLoadGameAsyncNode<TLambda>, DefaultSPMode>
+		{
+		public:
+			TLoadGameAsyncNode(FString const& InSlotName, int32 InUserIndex, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, USaveGame*>(InLambda)
+				, SlotName(InSlotName)
+				, UserIndex(InUserIndex)
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+				, DebugSlotName(*InSlotName)
+#endif
+			{}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				//there's no way to cancel the load, so a result arriving after the node ended is ignored
+				RequestAsyncLoadGame(SlotName, UserIndex, FOnAsyncSaveGameLoaded::CreateSP(this->AsShared(), &TLoadGameAsyncNode::OnLoaded));
+				return true;
+			}
+			void OnLoaded(USaveGame* SaveGame)
+			{
+				if (SaveGame)
+				{
+					this->DeliverResult(SaveGame);
+				}
+				else
+				{
+					this->FinishWithoutResult();
+				}
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("LoadGame {0}"), DebugSlotName); }
+#endif
+
+		private:
+			FString SlotName;
+			int32 UserIndex;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			FName DebugSlotName;
+#endif
+		};
+	}
+
+	//Saves the game to the slot without blocking the game thread on the write, and suspends until it's done.
+	//The save game object is serialized when the element starts. Fails if there's no object or the save failed
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _SaveGameAsync(USaveGame* SaveGame, FString const& SlotName, int32 UserIndex = 0);
+	//Same as above, with the save game object provided by a lambda when the element starts
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _SaveGameAsync(TFunction<USaveGame* ()> const& SaveGameGetter, FString const& SlotName, int32 UserIndex = 0);
+
+	//Loads the game from the slot without blocking the game thread, and suspends until it's done.
+	//The lambda receives the loaded USaveGame*, and can return void, bool, or a node to run in its place.
+	//Fails if the slot doesn't exist or can't be loaded
+	template <typename TLambda>
+	FCoroutineNodeRef _LoadGameAsync(FString const& SlotName, int32 UserIndex, TLambda const& Lambda)
+	{
+		return MakeShared<Detail::TLoadGameAsyncNode<TLambda>, DefaultSPMode>(SlotName, UserIndex, Lambda);
+	}
+}
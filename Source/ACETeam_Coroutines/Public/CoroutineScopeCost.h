@@ -0,0 +1,16 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineNode.h"
+
+namespace ACETeam_Coroutines
+{
+	//Sets how many milliseconds per frame the _NamedScope blocks with this name can take, added over all their instances and executors.
+	//The first time in a frame they go over it, the scope and the node that was running are logged. Zero or less removes the budget.
+	//Only checked in builds with the coroutine debugger, where named scopes exist
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+	ACETEAM_COROUTINES_API void SetScopeBudget(FName ScopeName, float BudgetMs);
+#else
+	inline void SetScopeBudget(FName ScopeName, float BudgetMs) {}
+#endif
+}
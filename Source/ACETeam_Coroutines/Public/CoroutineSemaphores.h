@@ -2,6 +2,8 @@
 #pragma once
 
 #include "CoroutineElements.h"
+#include "Containers/Ticker.h"
+#include "Runtime/Launch/Resources/Version.h"
 
 namespace ACETeam_Coroutines
 {
@@ -13,6 +15,26 @@ namespace ACETeam_Coroutines
 	typedef TSharedRef<Detail::FSemaphore> FSemaphoreRef;
 	typedef TSharedPtr<Detail::FSemaphore> FSemaphorePtr;
 	
+	struct FAdaptiveSemaphoreSettings
+	{
+		//Limits for the concurrency the controller is allowed to choose
+		int MinActive = 1;
+		int MaxActive = 16;
+		int InitialActive = 4;
+		//Cost in seconds above which the limit is reduced
+		double TargetCost = 1.0 / 60.0;
+		//Amount the limit grows per adjustment while there's headroom and branches are waiting
+		int AdditiveIncrease = 1;
+		//Factor the limit is scaled by when the cost is over the target
+		float MultiplicativeDecrease = 0.5f;
+		//Minimum time in seconds between adjustments, so the effect of the last one can be measured
+		double AdjustInterval = 0.25;
+		//Weight of new samples in the exponential moving average of the cost
+		float SmoothingFactor = 0.2f;
+		//Optional cost provider, in seconds. If not set, the game thread time of the last frame is used
+		TFunction<double ()> CostSampler;
+	};
+	
 	namespace Detail
 	{
 		class ACETEAM_COROUTINES_API FSemaphoreHandlerNode : public FCoroutineDecorator, public TSharedFromThis<FSemaphoreHandlerNode, DefaultSPMode>
@@ -31,7 +53,7 @@ namespace ACETeam_Coroutines
 			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
 			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Semaphore"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Semaphore"); }
 #endif
 		};
 
@@ -46,12 +68,23 @@ namespace ACETeam_Coroutines
 			{
 				check(MaxActive > 0);
 			}
+			virtual ~FSemaphore() {}
 			bool IsAvailable() const { return CurrentActive < MaxActive; }
 			bool TryTake(FSemaphoreHandlerRef const& Handler);
 			bool DropFromQueue(FSemaphoreHandlerRef const& Handler);
 			void Release();
 			void SetMaxActive(int NewMaxActive);
+			int GetMaxActive() const { return MaxActive; }
 			int GetCurrentActiveCount() const { return CurrentActive; }
+			int GetQueuedCount() const { return QueuedHandlers.Num(); }
+			
+		protected:
+			//Called whenever a handler takes or releases the semaphore, so subclasses can adjust the limit
+			virtual void Tune() {}
+			//Same as SetMaxActive, but without warning about lowering the limit below the current active count
+			void ApplyMaxActive(int NewMaxActive);
+			//Called after a handler had to wait in the queue
+			virtual void OnHandlerQueued() {}
 			
 		private:
 			int MaxActive = 1;
@@ -59,6 +92,40 @@ namespace ACETeam_Coroutines
 			TArray<FSemaphoreHandlerRef, TInlineAllocator<1>> QueuedHandlers;
 		};
 
+		/**
+		 * Semaphore that adjusts its own limit using an AIMD (additive increase, multiplicative decrease) controller.
+		 * The measured cost (by default the game thread time of the last frame) is smoothed and compared against a target.
+		 * While under the target and with branches waiting, the limit grows by a fixed step. When over the target,
+		 * it is scaled down, so expensive scoped sections self-throttle under load.
+		 */
+		class ACETEAM_COROUTINES_API FAdaptiveSemaphore : public FSemaphore
+		{
+		public:
+			FAdaptiveSemaphore(FAdaptiveSemaphoreSettings const& InSettings);
+			virtual ~FAdaptiveSemaphore() override;
+			FAdaptiveSemaphoreSettings const& GetSettings() const { return Settings; }
+			double GetSmoothedCost() const { return SmoothedCost; }
+			
+		protected:
+			virtual void Tune() override;
+			virtual void OnHandlerQueued() override;
+			
+		private:
+			//Keeps tuning every frame while branches are waiting, since holders that run for long wouldn't release it to trigger it
+			void StartTuneTicker();
+			void StopTuneTicker();
+
+			FAdaptiveSemaphoreSettings Settings;
+			double SmoothedCost = -1.0;
+			double LastAdjustTime = 0.0;
+			uint64 LastSampleFrame = 0;
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+			FTSTicker::FDelegateHandle TuneTickerHandle;
+#else
+			FDelegateHandle TuneTickerHandle;
+#endif
+		};
+
 		struct ACETEAM_COROUTINES_API FSemaphoreHelper
 		{
 			FSemaphoreHelper(FSemaphoreRef const& InSemaphore) :
@@ -80,4 +147,8 @@ namespace ACETeam_Coroutines
 	ACETEAM_COROUTINES_API Detail::FSemaphoreHelper _SemaphoreScope(FSemaphoreRef const& Semaphore);
 
 	ACETEAM_COROUTINES_API FSemaphoreRef MakeSemaphore(int MaxActive);
+
+	//Makes a semaphore whose limit is tuned at runtime from the measured frame cost, instead of a fixed MaxActive.
+	//Can be used with _SemaphoreScope like any other semaphore
+	ACETEAM_COROUTINES_API FSemaphoreRef MakeAdaptiveSemaphore(FAdaptiveSemaphoreSettings const& Settings = FAdaptiveSemaphoreSettings());
 }
\ No newline at end of file
@@ -3,7 +3,9 @@
 #include "CoroutineElements.h"
 #include "CoroutineNode.h"
 #include "FunctionTraits.h"
+#include "Containers/Ticker.h"
 #include "Engine/StreamableManager.h"
+#include "Runtime/Launch/Resources/Version.h"
 
 struct FStreamableHandle;
 
@@ -11,17 +13,270 @@ namespace ACETeam_Coroutines
 {
 	namespace Detail
 	{
+		struct FAssetStreamingNode;
+		
+		enum class EStreamingBatchState : uint8
+		{
+			Pending,	//Gathering requests until the end of the frame
+			Queued,		//Waiting for its category to have room for another request in flight
+			InFlight,
+			Completed,
+			Failed,		//None of the paths could be requested
+		};
+		
+		//Combined load request, shared by all the streaming nodes that started in the same frame with the same priority and category.
+		//_AssetScope issues requests of its own instead, so that their handles only keep the scope's assets loaded
+		struct ACETEAM_COROUTINES_API FStreamingBatch
+		{
+			TAsyncLoadPriority Priority;
+			FName Category;
+			EStreamingBatchState State = EStreamingBatchState::Pending;
+			double LastEscalationTime = 0.0;
+			TArray<FSoftObjectPath> Paths;
+			TSet<FSoftObjectPath> PathSet;
+			TArray<TWeakPtr<FAssetStreamingNode, DefaultSPMode>> Waiters;
+			TSharedPtr<FStreamableHandle> Handle;
+			//Request for the paths still loading at the raised priority, made after the batch was already in flight
+			TSharedPtr<FStreamableHandle> BoostHandle;
+
+			FStreamingBatch(TAsyncLoadPriority InPriority, FName InCategory) : Priority(InPriority), Category(InCategory) {}
+			bool IsFinished() const { return State == EStreamingBatchState::Completed || State == EStreamingBatchState::Failed; }
+		};
+
+		/**
+		 * Collects the _StreamAssets requests started during a frame, and issues them at the end of the frame as a single
+		 * request per priority and category, with duplicate paths removed.
+		 * Each waiting node is woken as soon as its own subset of the combined request is loaded.
+		 *
+		 * Categories can limit how many of their requests are in flight at the same time. Requests over the limit are
+		 * queued in priority order. Requests that branches have been waiting on for too long, either queued or in flight,
+		 * have their priority raised, so gameplay critical loads don't get stuck behind bulk prefetches. Prefetches no
+		 * branch is waiting on yet are left alone.
+		 */
+		class ACETEAM_COROUTINES_API FAssetStreamingCoordinator
+		{
+		public:
+			static FAssetStreamingCoordinator& Get();
+			//Null if the coordinator hasn't been created yet, or was already destroyed during static teardown
+			static FAssetStreamingCoordinator* TryGet();
+			
+			//Adds the paths to the pending batch for this priority and category, and registers the node to be notified about its progress
+			TSharedRef<FStreamingBatch> AddRequest(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category, TSharedRef<FAssetStreamingNode, DefaultSPMode> const& Waiter);
+			//Adds the paths to the pending low priority batch for this category, without anyone waiting on it
+			TSharedRef<FStreamingBatch> AddPrefetchRequest(TArray<FSoftObjectPath> const& Paths, FName Category);
+			//Queues a request for exactly these paths, not merged with any other, without anyone waiting on it
+			TSharedRef<FStreamingBatch> AddUnsharedRequest(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category);
+			//Raises the priority of a queued or in flight batch. Once in flight, the paths that still aren't loaded are
+			//requested again at the new priority, which the loader applies to the packages already loading
+			void RaisePriority(TSharedRef<FStreamingBatch> const& Batch, TAsyncLoadPriority NewPriority, TArray<FSoftObjectPath> const& PathsToBoost);
+			//Registers the node to be notified about the progress of a batch it didn't request
+			void AddWaiter(FStreamingBatch& Batch, TSharedRef<FAssetStreamingNode, DefaultSPMode> const& Waiter);
+			//Stops notifying the node about the batch
+			void RemoveWaiter(FStreamingBatch& Batch, FAssetStreamingNode* Waiter);
+			//Releases a reference to the batch. If no one else is interested in it, the request is dropped or canceled.
+			//Safe to call while a node is ending, since the queued requests this makes room for are issued at the end of the frame
+			void ReleaseBatch(TSharedPtr<FStreamingBatch>& Batch);
+			
+			//Limits how many requests of this category can be in flight at the same time. Zero or less means no limit.
+			//Queued requests the new limit lets through are issued at the end of the frame
+			void SetCategoryLimit(FName Category, int MaxInFlight);
+			int GetNumQueued(FName Category) const;
+			int GetNumInFlight(FName Category) const;
+			
+		private:
+			struct FCategoryState
+			{
+				TOptional<int> MaxInFlight;
+				int NumInFlight = 0;
+				//Sorted by descending priority, in arrival order for equal priorities
+				TArray<TSharedRef<FStreamingBatch>> Queue;
+			};
+			
+			FAssetStreamingCoordinator();
+			~FAssetStreamingCoordinator();
+			TSharedRef<FStreamingBatch> AddToPendingBatch(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category);
+			void ScheduleFlush();
+			void Flush();
+			void Enqueue(TSharedRef<FStreamingBatch> const& Batch);
+			void IssueQueuedRequests();
+			void Request(TSharedRef<FStreamingBatch> const& Batch);
+			bool HasWaitedRequests() const;
+			void ScheduleEscalation();
+			bool EscalateWaitedRequests(float);
+			void NotifyWaiters(TSharedRef<FStreamingBatch> const& Batch);
+			void OnBatchFinished(TSharedRef<FStreamingBatch> const& Batch, EStreamingBatchState FinalState);
+			int GetMaxInFlight(FCategoryState const& CategoryState) const;
+			
+			TMap<TPair<TAsyncLoadPriority, FName>, TSharedRef<FStreamingBatch>> PendingBatches;
+			TMap<FName, FCategoryState> Categories;
+			TArray<TSharedRef<FStreamingBatch>> InFlightBatches;
+			FDelegateHandle EndFrameHandle;
+			bool bIssuingRequests = false;
+			bool bIssueAgain = false;
+#if ENGINE_MAJOR_VERSION > 4 || ENGINE_MINOR_VERSION > 27
+			FTSTicker::FDelegateHandle EscalationHandle;
+#else
+			FDelegateHandle EscalationHandle;
+#endif
+		};
+		
 		struct ACETEAM_COROUTINES_API FAssetStreamingNode : FCoroutineNode, TSharedFromThis<FAssetStreamingNode, DefaultSPMode>
 		{
 			TFunction<TArray<FSoftObjectPath> ()> SoftObjectPathGetter;
 			FCoroutineExecutor* CachedExec = nullptr;
-			TSharedPtr<FStreamableHandle> Handle;
+			//Batch this node's request is part of. Holding it keeps the loaded assets referenced
+			TSharedPtr<FStreamingBatch> Batch;
+			//Keeps holding the batch after completing, so the assets that are still streaming keep loading.
+			//Otherwise it's released when the node ends, since it may also be keeping other requesters' assets loaded
+			bool bKeepLoaded = false;
+			//Taken over the node's own paths once it completes, so they stay referenced until the node is destroyed or
+			//restarted, without the batch pinning everyone else's assets
+			TSharedPtr<FStreamableHandle> OwnHandle;
+			TArray<FSoftObjectPath> RequestedPaths;
 			TAsyncLoadPriority AsyncLoadPriority;
+			FName Category;
+			//Only nodes whose paths can't change before they start can be prefetched
+			bool bCanPrefetch;
+			//Low priority request issued ahead of Start. Held until the node ends, the actual request is issued on Start
+			TSharedPtr<FStreamingBatch> PrefetchBatch;
+
+			FAssetStreamingNode(TFunction<TArray<FSoftObjectPath> ()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory = NAME_None, bool bInCanPrefetch = false);
+			virtual ~FAssetStreamingNode() override;
+
+			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+			virtual void Prefetch() override;
+			
+			//Called by the coordinator whenever the batch makes progress
+			virtual void OnBatchUpdated(FStreamingBatch const& UpdatedBatch);
+			bool AreRequestedPathsLoaded() const;
+			void HoldRequestedPaths();
+			void ReleaseOwnHandle();
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("StreamAssets"); }
+#endif
+		};
+		
+		/**
+		 * Streaming node that reports the fraction of its assets that are loaded, and resumes as soon as the required subset
+		 * is loaded. The rest of the assets keep streaming in the background, with progress still reported, for as long as
+		 * the node is kept alive.
+		 */
+		struct ACETEAM_COROUTINES_API FProgressiveStreamingNode : FAssetStreamingNode
+		{
+			//Empty means all the requested paths are required
+			TArray<FSoftObjectPath> RequiredPaths;
+			TFunction<void (float)> OnProgress;
+			float LastReportedProgress = -1.0f;
+
+			FProgressiveStreamingNode(TArray<FSoftObjectPath> const& InPaths, TArray<FSoftObjectPath> const& InRequiredPaths, TFunction<void (float)> const& InOnProgress, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory);
 
-			FAssetStreamingNode(TFunction<TArray<FSoftObjectPath> ()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority);
+			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+			virtual void OnBatchUpdated(FStreamingBatch const& UpdatedBatch) override;
+			float GetProgress() const;
+			bool AreRequiredPathsLoaded() const;
+			void ReportProgress();
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return FCoroutineDebugName(TEXT("StreamAssets {0}%"), FMath::RoundToInt(FMath::Max(LastReportedProgress, 0.0f) * 100.0f)); }
+#endif
+		};
+		
+		/**
+		 * Waits for the requests loading the paths of an _AssetScope. Some of them may have been issued by other scopes
+		 * that reference the same paths, so it doesn't request anything itself.
+		 */
+		struct ACETEAM_COROUTINES_API FResidentAssetWaitNode : FAssetStreamingNode
+		{
+			TArray<TSharedRef<FStreamingBatch>> PendingBatches;
+
+			FResidentAssetWaitNode(TArray<FSoftObjectPath> const& InPaths, TArray<TSharedRef<FStreamingBatch>>&& InPendingBatches);
+
+			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+			virtual void OnBatchUpdated(FStreamingBatch const& UpdatedBatch) override;
+			EStatus GetPendingBatchesStatus() const;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("AssetScopeLoad"); }
+#endif
+		};
+		
+		/**
+		 * Reference counts the assets kept resident by _AssetScope, each with a handle of its own that keeps it loaded.
+		 * The first scope to reference a path requests it, with a request of its own for exactly the paths it's missing.
+		 * Later scopes wait on that request while it's in flight instead of issuing another one, raising its priority if
+		 * they outrank it. Once loaded, each path takes its own handle and lets go of the request.
+		 * An asset stays referenced while any scope that requested it is running, so consecutive users don't reload it.
+		 * Once the last scope referencing it ends, the entry (and with it the handle) is dropped.
+		 */
+		class ACETEAM_COROUTINES_API FResidentAssetCache
+		{
+		public:
+			static FResidentAssetCache& Get();
+			
+			//Adds a reference to each path, requesting the ones no one is loading yet. Returns the unfinished requests
+			//loading any of the paths, so the scope can wait for them
+			void AddReferences(TArray<FSoftObjectPath> const& Paths, TAsyncLoadPriority Priority, FName Category, TArray<TSharedRef<FStreamingBatch>>& OutPendingBatches);
+			//Swaps the finished requests of these paths for handles of their own
+			void HoldLoadedPaths(TArray<FSoftObjectPath> const& Paths);
+			void RemoveReferences(TArray<FSoftObjectPath> const& Paths);
+			int GetNumResidentAssets() const { return Entries.Num(); }
+			
+		private:
+			struct FEntry
+			{
+				int32 RefCount = 0;
+				//Request issued by the first scope that referenced the path, shared with the other paths it was missing.
+				//Only held until the path is loaded
+				TSharedPtr<FStreamingBatch> Batch;
+				//Keeps just this path loaded, so it can be released regardless of the paths it was requested with
+				TSharedPtr<FStreamableHandle> Handle;
+			};
+			void HoldLoadedPath(FSoftObjectPath const& Path, FEntry& Entry);
+			TMap<FSoftObjectPath, FEntry> Entries;
+		};
 
+		class ACETEAM_COROUTINES_API FAssetScopeNode : public FCoroutineDecorator
+		{
+		public:
+			FAssetScopeNode(TFunction<TArray<FSoftObjectPath> ()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory);
+			
+		private:
+			TFunction<TArray<FSoftObjectPath> ()> SoftObjectPathGetter;
+			TAsyncLoadPriority AsyncLoadPriority;
+			FName Category;
+			TArray<FSoftObjectPath> ReferencedPaths;
+			TSharedPtr<FAssetStreamingNode, DefaultSPMode> LoadNode;
+			bool bHoldsReferences = false;
+			
+			void ReleaseReferences();
 			virtual EStatus Start(FCoroutineExecutor* Exec) override;
+			virtual EStatus OnChildStopped(FCoroutineExecutor* Exec, EStatus Status, FCoroutineNode* Child) override;
 			virtual void End(FCoroutineExecutor* Exec, EStatus Status) override;
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("AssetScope"); }
+#endif
+		};
+
+		struct ACETEAM_COROUTINES_API FAssetScopeHelper
+		{
+			FAssetScopeHelper(TFunction<TArray<FSoftObjectPath> ()> const& InGetter, TAsyncLoadPriority InAsyncLoadPriority, FName InCategory)
+				: SoftObjectPathGetter(InGetter)
+				, AsyncLoadPriority(InAsyncLoadPriority)
+				, Category(InCategory)
+			{}
+			
+			TFunction<TArray<FSoftObjectPath> ()> SoftObjectPathGetter;
+			TAsyncLoadPriority AsyncLoadPriority;
+			FName Category;
+
+			template <typename TChild>
+			FCoroutineNodeRef operator() (TChild&& ScopeBody)
+			{
+				auto Scope = MakeShared<FAssetScopeNode, DefaultSPMode>(SoftObjectPathGetter, AsyncLoadPriority, Category);
+				AddCoroutineChild(Scope, ScopeBody);
+				return Scope;
+			}
 		};
 		
 		template <typename T>
@@ -37,12 +292,12 @@ namespace ACETeam_Coroutines
 		constexpr bool TIsSoftClassPtrTArray_V<TArray<TSoftClassPtr<InObjectType>, InAllocatorType>> = true;
 	}
 
-	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssets(TArray<FSoftObjectPath> const& SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority);
-	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssets(std::initializer_list<FSoftObjectPath> SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority);
-	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssets(TFunction<TArray<FSoftObjectPath> ()> SoftObjectPathsGetter, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority);
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssets(TArray<FSoftObjectPath> const& SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssets(std::initializer_list<FSoftObjectPath> SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssets(TFunction<TArray<FSoftObjectPath> ()> SoftObjectPathsGetter, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
 
 	template<typename T>
-	FCoroutineNodeRef _StreamAssets(TArray<TSoftObjectPtr<T>> SoftObjects, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority)
+	FCoroutineNodeRef _StreamAssets(TArray<TSoftObjectPtr<T>> SoftObjects, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
 	{
 		TArray<FSoftObjectPath> SoftObjectPaths;
 		SoftObjectPaths.Reserve(SoftObjects.Num());
@@ -50,11 +305,11 @@ namespace ACETeam_Coroutines
 		{
 			SoftObjectPaths.Add(SoftObjPtr.ToSoftObjectPath());
 		}
-		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority);
+		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority, Category);
 	}
 
 	template<typename T>
-	FCoroutineNodeRef _StreamAssets(std::initializer_list<TSoftObjectPtr<T>> SoftObjects, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority)
+	FCoroutineNodeRef _StreamAssets(std::initializer_list<TSoftObjectPtr<T>> SoftObjects, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
 	{
 		TArray<FSoftObjectPath> SoftObjectPaths;
 		SoftObjectPaths.Reserve(SoftObjects.size());
@@ -62,11 +317,11 @@ namespace ACETeam_Coroutines
 		{
 			SoftObjectPaths.Add(SoftObjPtr.ToSoftObjectPath());
 		}
-		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority);
+		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority, Category);
 	}
 
 	template<typename T>
-	FCoroutineNodeRef _StreamAssets(TArray<TSoftClassPtr<T>> SoftClasses, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority)
+	FCoroutineNodeRef _StreamAssets(TArray<TSoftClassPtr<T>> SoftClasses, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
 	{
 		TArray<FSoftObjectPath> SoftObjectPaths;
 		SoftObjectPaths.Reserve(SoftClasses.Num());
@@ -74,11 +329,11 @@ namespace ACETeam_Coroutines
 		{
 			SoftObjectPaths.Add(SoftClassPtr.ToSoftObjectPath());
 		}
-		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority);
+		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority, Category);
 	}
 
 	template<typename T>
-	FCoroutineNodeRef _StreamAssets(std::initializer_list<TSoftClassPtr<T>> SoftClasses, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority)
+	FCoroutineNodeRef _StreamAssets(std::initializer_list<TSoftClassPtr<T>> SoftClasses, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
 	{
 		TArray<FSoftObjectPath> SoftObjectPaths;
 		SoftObjectPaths.Reserve(SoftClasses.size());
@@ -86,17 +341,17 @@ namespace ACETeam_Coroutines
 		{
 			SoftObjectPaths.Add(SoftClassPtr.ToSoftObjectPath());
 		}
-		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority);
+		return _StreamAssets(SoftObjectPaths, AsyncLoadPriority, Category);
 	}
 
 	template<typename TFunctor>
 	typename TEnableIf<TIsFunctor_V<TFunctor>, FCoroutineNodeRef>::Type
-	_StreamAssets(TFunctor Getter, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority)
+	_StreamAssets(TFunctor Getter, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
 	{
 		typedef typename TFunctorTraits<TFunctor>::RetType RetType;
 		if constexpr (std::is_same_v<RetType, TArray<FSoftObjectPath>>)
 		{
-			return _StreamAssets(TFunction<TArray<FSoftObjectPath> ()>(Getter), AsyncLoadPriority);
+			return _StreamAssets(TFunction<TArray<FSoftObjectPath> ()>(Getter), AsyncLoadPriority, Category);
 		}
 		else if constexpr (Detail::TIsSoftObjectPtrTArray_V<RetType> || Detail::TIsSoftClassPtrTArray_V<RetType>)
 		{
@@ -110,7 +365,7 @@ namespace ACETeam_Coroutines
 					SoftObjectPaths.Add(SoftObjPtr.ToSoftObjectPath());
 				}
 				return SoftObjectPaths;
-			}, AsyncLoadPriority);
+			}, AsyncLoadPriority, Category);
 		}
 		else
 		{
@@ -121,4 +376,44 @@ namespace ACETeam_Coroutines
 			return _Error();
 		}
 	}
+
+	//Streams the assets, calling OnProgress with the fraction of them that is loaded whenever it changes.
+	//The branch resumes as soon as RequiredPaths (or all of them, if empty) are loaded, while the rest keep loading
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssetsWithProgress(TArray<FSoftObjectPath> const& SoftObjectPaths, TFunction<void (float)> OnProgress, TArray<FSoftObjectPath> const& RequiredPaths = {}, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
+	//Same as above, but writing the progress into a coroutine variable
+	ACETEAM_COROUTINES_API FCoroutineNodeRef _StreamAssetsWithProgress(TArray<FSoftObjectPath> const& SoftObjectPaths, TCoroVar<float> Progress, TArray<FSoftObjectPath> const& RequiredPaths = {}, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
+
+	//Loads the assets and keeps them resident while the scope body runs. Assets shared by several running scopes are
+	//only loaded once, and are released for garbage collection once the last scope referencing them ends.
+	//Usage example:
+	//_AssetScope({ SoftPath1, SoftPath2 })
+	//(
+	//  ... body
+	//)
+	ACETEAM_COROUTINES_API Detail::FAssetScopeHelper _AssetScope(TArray<FSoftObjectPath> const& SoftObjectPaths, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
+	ACETEAM_COROUTINES_API Detail::FAssetScopeHelper _AssetScope(TFunction<TArray<FSoftObjectPath> ()> SoftObjectPathsGetter, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None);
+
+	template<typename T>
+	Detail::FAssetScopeHelper _AssetScope(TArray<TSoftObjectPtr<T>> SoftObjects, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
+	{
+		TArray<FSoftObjectPath> SoftObjectPaths;
+		SoftObjectPaths.Reserve(SoftObjects.Num());
+		for (auto& SoftObjPtr : SoftObjects)
+		{
+			SoftObjectPaths.Add(SoftObjPtr.ToSoftObjectPath());
+		}
+		return _AssetScope(SoftObjectPaths, AsyncLoadPriority, Category);
+	}
+
+	template<typename T>
+	Detail::FAssetScopeHelper _AssetScope(TArray<TSoftClassPtr<T>> SoftClasses, TAsyncLoadPriority AsyncLoadPriority = FStreamableManager::DefaultAsyncLoadPriority, FName Category = NAME_None)
+	{
+		TArray<FSoftObjectPath> SoftObjectPaths;
+		SoftObjectPaths.Reserve(SoftClasses.Num());
+		for (auto& SoftClassPtr : SoftClasses)
+		{
+			SoftObjectPaths.Add(SoftClassPtr.ToSoftObjectPath());
+		}
+		return _AssetScope(SoftObjectPaths, AsyncLoadPriority, Category);
+	}
 }
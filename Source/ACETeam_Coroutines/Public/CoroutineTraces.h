@@ -0,0 +1,126 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+#pragma once
+
+#include "CoroutineAsyncResult.h"
+#include "CoroutineParameter.h"
+#include "WorldCollision.h"
+#include "Runtime/Launch/Resources/Version.h"
+#if ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1)
+#include "Engine/HitResult.h"
+#include "Engine/OverlapResult.h"
+#endif
+
+namespace ACETeam_Coroutines
+{
+	struct FAsyncTraceSettings
+	{
+		ECollisionChannel Channel = ECC_Visibility;
+		FCollisionQueryParams Params = FCollisionQueryParams::DefaultQueryParam;
+		FCollisionResponseParams ResponseParams = FCollisionResponseParams::DefaultResponseParam;
+	};
+
+	namespace Detail
+	{
+		//Queue the query in the world's async trace buffer. Return false if there's no world to trace against
+		ACETEAM_COROUTINES_API bool RequestAsyncLineTrace(UObject* WorldContextObject, EAsyncTraceType TraceType, FVector const& Start, FVector const& End,
+			FAsyncTraceSettings const& Settings, FTraceDelegate const& Delegate);
+		ACETEAM_COROUTINES_API bool RequestAsyncOverlap(UObject* WorldContextObject, FVector const& Position, FQuat const& Rotation, FCollisionShape const& Shape,
+			FAsyncTraceSettings const& Settings, FOverlapDelegate const& Delegate);
+
+		template <typename TLambda>
+		class TAsyncLineTraceNode : public TAsyncResultNodeFor<TLambda, TArray<FHitResult>>, public TSharedFromThis<TAsyncLineTraceNode<TLambda>, DefaultSPMode>
+		{
+		public:
+			TAsyncLineTraceNode(UObject* InWorldContextObject, EAsyncTraceType InTraceType, TFunction<FVector ()> const& InStart, TFunction<FVector ()> const& InEnd,
+				FAsyncTraceSettings const& InSettings, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, TArray<FHitResult>>(InLambda)
+				, WorldContextObject(InWorldContextObject)
+				, TraceType(InTraceType)
+				, StartProvider(InStart)
+				, EndProvider(InEnd)
+				, Settings(InSettings)
+			{}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				//bound weakly, results for a node that already ended are dropped by the base class
+				return RequestAsyncLineTrace(WorldContextObject.Get(), TraceType, StartProvider(), EndProvider(), Settings,
+					FTraceDelegate::CreateSP(this->AsShared(), &TAsyncLineTraceNode::OnTraceDone));
+			}
+			void OnTraceDone(FTraceHandle const&, FTraceDatum& Datum)
+			{
+				this->DeliverResult(Datum.OutHits);
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("AsyncLineTrace"); }
+#endif
+
+		private:
+			TWeakObjectPtr<UObject> WorldContextObject;
+			EAsyncTraceType TraceType;
+			TFunction<FVector ()> StartProvider;
+			TFunction<FVector ()> EndProvider;
+			FAsyncTraceSettings Settings;
+		};
+
+		template <typename TLambda>
+		class TAsyncOverlapNode : public TAsyncResultNodeFor<TLambda, TArray<FOverlapResult>>, public TSharedFromThis<TAsyncOverlapNode<TLambda>, DefaultSPMode>
+		{
+		public:
+			TAsyncOverlapNode(UObject* InWorldContextObject, TFunction<FVector ()> const& InPosition, FCollisionShape const& InShape,
+				FAsyncTraceSettings const& InSettings, TLambda const& InLambda)
+				: TAsyncResultNodeFor<TLambda, TArray<FOverlapResult>>(InLambda)
+				, WorldContextObject(InWorldContextObject)
+				, PositionProvider(InPosition)
+				, Shape(InShape)
+				, Settings(InSettings)
+			{}
+
+		protected:
+			virtual bool StartRequest() override
+			{
+				return RequestAsyncOverlap(WorldContextObject.Get(), PositionProvider(), FQuat::Identity, Shape, Settings,
+					FOverlapDelegate::CreateSP(this->AsShared(), &TAsyncOverlapNode::OnOverlapDone));
+			}
+			void OnOverlapDone(FTraceHandle const&, FOverlapDatum& Datum)
+			{
+				this->DeliverResult(Datum.OutOverlaps);
+			}
+#if WITH_ACETEAM_COROUTINE_DEBUGGER
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("AsyncOverlap"); }
+#endif
+
+		private:
+			TWeakObjectPtr<UObject> WorldContextObject;
+			TFunction<FVector ()> PositionProvider;
+			FCollisionShape Shape;
+			FAsyncTraceSettings Settings;
+		};
+	}
+
+	//Queues a line trace in the world's async trace buffer, and suspends until its results come back next frame.
+	//All the async traces requested during a frame, by coroutines or anything else, are run together as a batch.
+	//Start and End can be constants, TCoroVar or lambdas, and are evaluated when the element starts.
+	//The lambda receives the hits as TArray<FHitResult> const&, and can return void, bool, or a node to run in its place
+	template <typename TStartParam, typename TEndParam, typename TLambda>
+	FCoroutineNodeRef _AsyncLineTrace(UObject* WorldContextObject, TStartParam const& Start, TEndParam const& End, TLambda const& Lambda,
+		EAsyncTraceType TraceType = EAsyncTraceType::Single, FAsyncTraceSettings const& Settings = FAsyncTraceSettings())
+	{
+		static_assert(Detail::TIsCoroutineParam_V<FVector, TStartParam>, "Start needs to either be an FVector constant, TCoroVar<FVector>, or a lambda that returns FVector");
+		static_assert(Detail::TIsCoroutineParam_V<FVector, TEndParam>, "End needs to either be an FVector constant, TCoroVar<FVector>, or a lambda that returns FVector");
+		return MakeShared<Detail::TAsyncLineTraceNode<TLambda>, DefaultSPMode>(WorldContextObject, TraceType,
+			Detail::ParameterHelper<FVector, TStartParam>(Start), Detail::ParameterHelper<FVector, TEndParam>(End), Settings, Lambda);
+	}
+
+	//Queues an overlap test in the world's async trace buffer, and suspends until its results come back next frame.
+	//The lambda receives the overlaps as TArray<FOverlapResult> const&
+	template <typename TPositionParam, typename TLambda>
+	FCoroutineNodeRef _AsyncOverlap(UObject* WorldContextObject, TPositionParam const& Position, FCollisionShape const& Shape, TLambda const& Lambda,
+		FAsyncTraceSettings const& Settings = FAsyncTraceSettings())
+	{
+		static_assert(Detail::TIsCoroutineParam_V<FVector, TPositionParam>, "Position needs to either be an FVector constant, TCoroVar<FVector>, or a lambda that returns FVector");
+		return MakeShared<Detail::TAsyncOverlapNode<TLambda>, DefaultSPMode>(WorldContextObject,
+			Detail::ParameterHelper<FVector, TPositionParam>(Position), Shape, Settings, Lambda);
+	}
+}
@@ -75,7 +75,7 @@ namespace ACETeam_Coroutines
 				return CurAlpha < 1.0f ? Running : Completed;
 			}
 #if WITH_ACETEAM_COROUTINE_DEBUGGER
-			virtual FString Debug_GetName() const override { return TEXT("Tween"); }
+			virtual FCoroutineDebugName Debug_GetName() const override { return TEXT("Tween"); }
 #endif
 
 		public:
@@ -0,0 +1,28 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+using UnrealBuildTool;
+
+public class ACETeam_CoroutinesInsights : ModuleRules
+{
+	public ACETeam_CoroutinesInsights(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = ModuleRules.PCHUsageMode.UseExplicitOrSharedPCHs;
+
+		PublicDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"Core",
+			}
+			);
+
+		PrivateDependencyModuleNames.AddRange(
+			new string[]
+			{
+				"TraceAnalysis",
+				"TraceServices",
+			}
+			);
+
+		bUseUnity = false;
+	}
+}
@@ -0,0 +1,22 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#include "ACETeam_CoroutinesInsightsModule.h"
+
+#include "Features/IModularFeatures.h"
+
+void FACETeam_CoroutinesInsightsModule::StartupModule()
+{
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+	//Trace analysis picks up every module registered under this feature when a session starts
+	IModularFeatures::Get().RegisterModularFeature(TraceServices::ModuleFeatureName, &TraceModule);
+#endif
+}
+
+void FACETeam_CoroutinesInsightsModule::ShutdownModule()
+{
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+	IModularFeatures::Get().UnregisterModularFeature(TraceServices::ModuleFeatureName, &TraceModule);
+#endif
+}
+
+IMPLEMENT_MODULE(FACETeam_CoroutinesInsightsModule, ACETeam_CoroutinesInsights)
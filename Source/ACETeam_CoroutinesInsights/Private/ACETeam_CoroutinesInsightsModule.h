@@ -0,0 +1,18 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CoroutinesTraceModule.h"
+
+class FACETeam_CoroutinesInsightsModule : public IModuleInterface
+{
+public:
+
+	/** IModuleInterface implementation */
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+
+private:
+	FCoroutinesTraceModule TraceModule;
+};
@@ -0,0 +1,93 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#include "CoroutinesTraceAnalyzer.h"
+
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+
+#include "CoroutinesTraceProvider.h"
+#include "TraceServices/Model/AnalysisSession.h"
+
+FCoroutinesTraceAnalyzer::FCoroutinesTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FCoroutinesTraceProvider& InProvider)
+	: Session(InSession)
+	, Provider(InProvider)
+{
+}
+
+void FCoroutinesTraceAnalyzer::OnAnalysisBegin(const FOnAnalysisContext& Context)
+{
+	auto& Builder = Context.InterfaceBuilder;
+	Builder.RouteEvent(RouteId_NodeName, "Coroutines", "NodeName");
+	Builder.RouteEvent(RouteId_NodeStart, "Coroutines", "NodeStart");
+	Builder.RouteEvent(RouteId_NodeSuspend, "Coroutines", "NodeSuspend");
+	Builder.RouteEvent(RouteId_NodeResume, "Coroutines", "NodeResume");
+	Builder.RouteEvent(RouteId_NodeEnd, "Coroutines", "NodeEnd");
+	Builder.RouteEvent(RouteId_ExecutorStep, "Coroutines", "ExecutorStep");
+	Builder.RouteEvent(RouteId_WakeUp, "Coroutines", "WakeUp");
+}
+
+bool FCoroutinesTraceAnalyzer::OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context)
+{
+	TraceServices::FAnalysisSessionEditScope _(Session);
+
+	const auto& EventData = Context.EventData;
+	auto TimeOf = [&](const ANSICHAR* Field)
+	{
+		const double Time = Context.EventTime.AsSeconds(EventData.GetValue<uint64>(Field));
+		Session.UpdateDurationSeconds(Time);
+		return Time;
+	};
+	switch (RouteId)
+	{
+	case RouteId_NodeName:
+		{
+			FString Name;
+			EventData.GetString("Name", Name);
+			Provider.AddName(EventData.GetValue<uint32>("Id"), Name);
+			break;
+		}
+	case RouteId_NodeStart:
+		{
+			FCoroutinesTraceProvider::FNodeName Name;
+			Name.NameId = EventData.GetValue<uint32>("NameId");
+			Name.ParamType = EventData.GetValue<uint8>("ParamType");
+			Name.FloatParam = EventData.GetValue<float>("FloatParam");
+			Name.IntParam = EventData.GetValue<int32>("IntParam");
+			Provider.OnNodeStart(TimeOf("Cycle"), EventData.GetValue<uint64>("ExecutorId"), EventData.GetValue<uint64>("NodeId"),
+				EventData.GetValue<uint64>("ParentId"), Name, EventData.GetValue<uint8>("Status"));
+			break;
+		}
+	case RouteId_NodeSuspend:
+		Provider.OnNodeSuspend(TimeOf("Cycle"), EventData.GetValue<uint64>("NodeId"));
+		break;
+	case RouteId_NodeResume:
+		Provider.OnNodeResume(TimeOf("Cycle"), EventData.GetValue<uint64>("NodeId"));
+		break;
+	case RouteId_NodeEnd:
+		Provider.OnNodeEnd(TimeOf("Cycle"), EventData.GetValue<uint64>("NodeId"), EventData.GetValue<uint8>("Status"));
+		break;
+	case RouteId_ExecutorStep:
+		{
+			FCoroutinesTraceProvider::FExecutorStep Step;
+			Step.ExecutorId = EventData.GetValue<uint64>("ExecutorId");
+			Step.StartTime = TimeOf("StartCycle");
+			Step.EndTime = TimeOf("EndCycle");
+			Step.NumActive = EventData.GetValue<int32>("NumActive");
+			Step.NumSuspended = EventData.GetValue<int32>("NumSuspended");
+			Provider.OnExecutorStep(Step);
+			break;
+		}
+	case RouteId_WakeUp:
+		{
+			FCoroutinesTraceProvider::FWakeUp WakeUp;
+			WakeUp.Source = EventData.GetValue<uint8>("Source");
+			WakeUp.WakeTime = TimeOf("WakeCycle");
+			WakeUp.ResumeTime = TimeOf("Cycle");
+			WakeUp.Steps = EventData.GetValue<int32>("Steps");
+			Provider.OnWakeUp(EventData.GetValue<uint64>("NodeId"), WakeUp);
+			break;
+		}
+	}
+	return true;
+}
+
+#endif
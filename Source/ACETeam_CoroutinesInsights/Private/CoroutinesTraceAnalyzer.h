@@ -0,0 +1,43 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#pragma once
+
+#include "CoroutinesTraceModule.h"
+
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+
+#include "Trace/Analyzer.h"
+
+class FCoroutinesTraceProvider;
+
+namespace TraceServices
+{
+	class IAnalysisSession;
+}
+
+//Routes the events of the Coroutines trace channel to the provider
+class FCoroutinesTraceAnalyzer : public UE::Trace::IAnalyzer
+{
+public:
+	FCoroutinesTraceAnalyzer(TraceServices::IAnalysisSession& InSession, FCoroutinesTraceProvider& InProvider);
+
+	virtual void OnAnalysisBegin(const FOnAnalysisContext& Context) override;
+	virtual bool OnEvent(uint16 RouteId, EStyle Style, const FOnEventContext& Context) override;
+
+private:
+	enum : uint16
+	{
+		RouteId_NodeName,
+		RouteId_NodeStart,
+		RouteId_NodeSuspend,
+		RouteId_NodeResume,
+		RouteId_NodeEnd,
+		RouteId_ExecutorStep,
+		RouteId_WakeUp,
+	};
+
+	TraceServices::IAnalysisSession& Session;
+	FCoroutinesTraceProvider& Provider;
+};
+
+#endif
@@ -0,0 +1,42 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#include "CoroutinesTraceModule.h"
+
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+
+#include "CoroutinesTraceAnalyzer.h"
+#include "CoroutinesTraceProvider.h"
+#include "Misc/Paths.h"
+
+static const FName CoroutinesTraceModuleName("TraceModule_Coroutines");
+
+void FCoroutinesTraceModule::GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo)
+{
+	OutModuleInfo.Name = CoroutinesTraceModuleName;
+	OutModuleInfo.DisplayName = TEXT("Coroutines");
+}
+
+void FCoroutinesTraceModule::OnAnalysisBegin(TraceServices::IAnalysisSession& Session)
+{
+	TSharedPtr<FCoroutinesTraceProvider> Provider = MakeShared<FCoroutinesTraceProvider>(Session);
+	Session.AddProvider(FCoroutinesTraceProvider::ProviderName, Provider);
+	Session.AddAnalyzer(new FCoroutinesTraceAnalyzer(Session, *Provider));
+}
+
+void FCoroutinesTraceModule::GetLoggers(TArray<const TCHAR*>& OutLoggers)
+{
+	OutLoggers.Add(TEXT("Coroutines"));
+}
+
+void FCoroutinesTraceModule::GenerateReports(const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory)
+{
+	TraceServices::FAnalysisSessionReadScope _(Session);
+	const FCoroutinesTraceProvider* Provider = Session.ReadProvider<FCoroutinesTraceProvider>(FCoroutinesTraceProvider::ProviderName);
+	if (!Provider)
+		return;
+	Provider->WriteNodesReport(FPaths::Combine(OutputDirectory, TEXT("CoroutineNodes.csv")));
+	Provider->WriteExecutorStepsReport(FPaths::Combine(OutputDirectory, TEXT("CoroutineExecutorSteps.csv")));
+	Provider->WriteWakeUpsReport(FPaths::Combine(OutputDirectory, TEXT("CoroutineWakeUps.csv")));
+}
+
+#endif
@@ -0,0 +1,35 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Runtime/Launch/Resources/Version.h"
+
+//Written against the trace analysis API of UE 5.1 onwards
+#define ACETEAM_COROUTINES_INSIGHTS_ENABLED (ENGINE_MAJOR_VERSION > 5 || (ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1))
+
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+
+#include "TraceServices/ModuleService.h"
+
+/**
+ * Adds the analyzer and provider for the Coroutines trace channel to every analysis session,
+ * and writes the coroutine trees reconstructed from it as CSV reports.
+ */
+class FCoroutinesTraceModule : public TraceServices::IModule
+{
+public:
+	virtual void GetModuleInfo(TraceServices::FModuleInfo& OutModuleInfo) override;
+	virtual void OnAnalysisBegin(TraceServices::IAnalysisSession& Session) override;
+	virtual void GetLoggers(TArray<const TCHAR*>& OutLoggers) override;
+	virtual void GenerateReports(const TraceServices::IAnalysisSession& Session, const TCHAR* CmdLine, const TCHAR* OutputDirectory) override;
+	virtual const TCHAR* GetCommandLineArgument() override { return TEXT("coroutinestrace"); }
+};
+
+#else
+
+class FCoroutinesTraceModule
+{
+};
+
+#endif
@@ -0,0 +1,180 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#include "CoroutinesTraceProvider.h"
+
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+
+#include "Misc/FileHelper.h"
+
+const TCHAR* CoroutineTraceStatus::ToString(uint8 Status)
+{
+	switch (Status)
+	{
+	case Completed: return TEXT("Completed");
+	case Failed: return TEXT("Failed");
+	case Running: return TEXT("Running");
+	case Suspended: return TEXT("Suspended");
+	case Aborted: return TEXT("Aborted");
+	default: return TEXT("");
+	}
+}
+
+const TCHAR* CoroutineTraceWakeSource::ToString(uint8 Source)
+{
+	static const TCHAR* Names[] = { TEXT("None"), TEXT("Event"), TEXT("Async"), TEXT("Streaming"), TEXT("Semaphore"), TEXT("Lock"), TEXT("RateLimit") };
+	return Source < UE_ARRAY_COUNT(Names) ? Names[Source] : TEXT("");
+}
+
+const FName FCoroutinesTraceProvider::ProviderName("CoroutinesTraceProvider");
+
+FCoroutinesTraceProvider::FCoroutinesTraceProvider(TraceServices::IAnalysisSession& InSession)
+	: Session(InSession)
+{
+}
+
+void FCoroutinesTraceProvider::AddName(uint32 NameId, FString const& Name)
+{
+	Session.WriteAccessCheck();
+	Names.Add(NameId, Name);
+}
+
+void FCoroutinesTraceProvider::OnNodeStart(double Time, uint64 ExecutorId, uint64 NodeId, uint64 ParentId, FNodeName const& Name, uint8 Status)
+{
+	Session.WriteAccessCheck();
+	const int32* ParentIndex = ParentId != 0 ? LiveNodes.Find(ParentId) : nullptr;
+	FNodeRecord Node;
+	Node.ExecutorId = ExecutorId;
+	Node.NodeId = NodeId;
+	Node.ParentIndex = ParentIndex ? *ParentIndex : INDEX_NONE;
+	Node.Depth = ParentIndex ? Nodes[*ParentIndex].Depth + 1 : 0;
+	Node.Name = Name;
+	Node.StartTime = Time;
+	if (Status == CoroutineTraceStatus::Suspended)
+	{
+		Node.SuspendStartTime = Time;
+	}
+	//nodes that finish right away still get their end event, which takes them out of the live ones
+	LiveNodes.Add(NodeId, Nodes.Add(Node));
+}
+
+void FCoroutinesTraceProvider::OnNodeSuspend(double Time, uint64 NodeId)
+{
+	Session.WriteAccessCheck();
+	FNodeRecord* Node = FindLiveNode(NodeId);
+	if (Node && Node->SuspendStartTime < 0.0)
+	{
+		Node->SuspendStartTime = Time;
+	}
+}
+
+void FCoroutinesTraceProvider::OnNodeResume(double Time, uint64 NodeId)
+{
+	Session.WriteAccessCheck();
+	FNodeRecord* Node = FindLiveNode(NodeId);
+	if (Node && Node->SuspendStartTime >= 0.0)
+	{
+		Node->SuspendedTime += Time - Node->SuspendStartTime;
+		Node->SuspendStartTime = -1.0;
+		++Node->NumResumes;
+	}
+}
+
+void FCoroutinesTraceProvider::OnNodeEnd(double Time, uint64 NodeId, uint8 Status)
+{
+	Session.WriteAccessCheck();
+	//nodes aborted before they started never had a record
+	FNodeRecord* Node = FindLiveNode(NodeId);
+	if (!Node)
+		return;
+	if (Node->SuspendStartTime >= 0.0)
+	{
+		Node->SuspendedTime += Time - Node->SuspendStartTime;
+		Node->SuspendStartTime = -1.0;
+	}
+	Node->EndTime = Time;
+	Node->EndStatus = Status;
+	LiveNodes.Remove(NodeId);
+}
+
+void FCoroutinesTraceProvider::OnExecutorStep(FExecutorStep const& Step)
+{
+	Session.WriteAccessCheck();
+	Steps.Add(Step);
+}
+
+void FCoroutinesTraceProvider::OnWakeUp(uint64 NodeId, FWakeUp WakeUp)
+{
+	Session.WriteAccessCheck();
+	if (const int32* Index = LiveNodes.Find(NodeId))
+	{
+		WakeUp.NodeIndex = *Index;
+	}
+	WakeUps.Add(WakeUp);
+}
+
+FString const& FCoroutinesTraceProvider::GetName(uint32 NameId) const
+{
+	static const FString Unnamed;
+	const FString* Name = Names.Find(NameId);
+	return Name ? *Name : Unnamed;
+}
+
+FString FCoroutinesTraceProvider::FormatName(FNodeName const& Name) const
+{
+	const FString& Pattern = GetName(Name.NameId);
+	switch (Name.ParamType)
+	{
+	case CoroutineTraceNameParam::Float: return Pattern.Replace(TEXT("{0}"), *FString::Printf(TEXT("%.1f"), Name.FloatParam));
+	case CoroutineTraceNameParam::Int: return Pattern.Replace(TEXT("{0}"), *FString::FromInt(Name.IntParam));
+	default: return Pattern;
+	}
+}
+
+FCoroutinesTraceProvider::FNodeRecord* FCoroutinesTraceProvider::FindLiveNode(uint64 NodeId)
+{
+	const int32* Index = LiveNodes.Find(NodeId);
+	return Index ? &Nodes[*Index] : nullptr;
+}
+
+bool FCoroutinesTraceProvider::WriteNodesReport(FString const& Path) const
+{
+	Session.ReadAccessCheck();
+	FString Csv = TEXT("Index,ParentIndex,Depth,Name,ExecutorId,StartTime,EndTime,Duration,SuspendedTime,Resumes,EndStatus\n");
+	for (int32 Index = 0; Index < Nodes.Num(); ++Index)
+	{
+		const FNodeRecord& Node = Nodes[Index];
+		//still running when the capture ended
+		const double EndTime = Node.EndTime >= 0.0 ? Node.EndTime : Session.GetDurationSeconds();
+		Csv += FString::Printf(TEXT("%d,%d,%d,\"%s\",%llu,%f,%f,%f,%f,%d,%s\n"),
+			Index, Node.ParentIndex, Node.Depth, *FormatName(Node.Name).Replace(TEXT("\""), TEXT("\"\"")), Node.ExecutorId,
+			Node.StartTime, EndTime, EndTime - Node.StartTime, Node.SuspendedTime, Node.NumResumes,
+			Node.EndTime >= 0.0 ? CoroutineTraceStatus::ToString(Node.EndStatus) : TEXT("Unfinished"));
+	}
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool FCoroutinesTraceProvider::WriteExecutorStepsReport(FString const& Path) const
+{
+	Session.ReadAccessCheck();
+	FString Csv = TEXT("ExecutorId,StartTime,Duration,NumActive,NumSuspended\n");
+	for (const FExecutorStep& Step : Steps)
+	{
+		Csv += FString::Printf(TEXT("%llu,%f,%f,%d,%d\n"), Step.ExecutorId, Step.StartTime, Step.EndTime - Step.StartTime, Step.NumActive, Step.NumSuspended);
+	}
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+bool FCoroutinesTraceProvider::WriteWakeUpsReport(FString const& Path) const
+{
+	Session.ReadAccessCheck();
+	FString Csv = TEXT("NodeIndex,Name,Source,WakeTime,ResumeTime,LatencyMs,Steps\n");
+	for (const FWakeUp& WakeUp : WakeUps)
+	{
+		const FString Name = WakeUp.NodeIndex != INDEX_NONE ? FormatName(Nodes[WakeUp.NodeIndex].Name) : FString();
+		Csv += FString::Printf(TEXT("%d,\"%s\",%s,%f,%f,%f,%d\n"), WakeUp.NodeIndex, *Name.Replace(TEXT("\""), TEXT("\"\"")),
+			CoroutineTraceWakeSource::ToString(WakeUp.Source), WakeUp.WakeTime, WakeUp.ResumeTime, (WakeUp.ResumeTime - WakeUp.WakeTime) * 1000.0, WakeUp.Steps);
+	}
+	return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+#endif
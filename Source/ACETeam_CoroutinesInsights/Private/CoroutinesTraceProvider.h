@@ -0,0 +1,132 @@
+// Copyright ACE Team Software S.A. All Rights Reserved.
+
+#pragma once
+
+#include "CoroutinesTraceModule.h"
+
+#if ACETEAM_COROUTINES_INSIGHTS_ENABLED
+
+#include "TraceServices/Model/AnalysisSession.h"
+
+//Same values as ACETeam_Coroutines::EStatus, as sent in the trace
+namespace CoroutineTraceStatus
+{
+	enum : uint8
+	{
+		Completed = 1<<1,
+		Failed = 1<<2,
+		Running = 1<<3,
+		Suspended = 1<<4,
+		Aborted = 1<<5,
+	};
+
+	const TCHAR* ToString(uint8 Status);
+}
+
+//Same values as FCoroutineDebugName::EParam
+namespace CoroutineTraceNameParam
+{
+	enum : uint8
+	{
+		None,
+		Float,
+		Int,
+		Name,
+	};
+}
+
+//Same values as ACETeam_Coroutines::EWakeSource
+namespace CoroutineTraceWakeSource
+{
+	const TCHAR* ToString(uint8 Source);
+}
+
+/**
+ * Coroutine trees reconstructed from the Coroutines trace channel.
+ * Every time a node starts it gets a new record, linked to the record of the parent that was running it at the time.
+ * Node addresses are reused after they end, so only the records of nodes that are still running can be found by address.
+ */
+class FCoroutinesTraceProvider : public TraceServices::IProvider
+{
+public:
+	static const FName ProviderName;
+
+	//Interned name of a node, plus the numeric parameter that replaces {0} in it, which is sent on every start
+	struct FNodeName
+	{
+		uint32 NameId = 0;
+		uint8 ParamType = CoroutineTraceNameParam::None;
+		float FloatParam = 0.0f;
+		int32 IntParam = 0;
+	};
+
+	struct FNodeRecord
+	{
+		uint64 ExecutorId = 0;
+		uint64 NodeId = 0;
+		int32 ParentIndex = INDEX_NONE;
+		int32 Depth = 0;
+		FNodeName Name;
+		double StartTime = 0.0;
+		double EndTime = -1.0;
+		//time spent suspended, waiting for children or for something outside the executor
+		double SuspendedTime = 0.0;
+		double SuspendStartTime = -1.0;
+		int32 NumResumes = 0;
+		uint8 EndStatus = 0;
+	};
+
+	struct FExecutorStep
+	{
+		uint64 ExecutorId = 0;
+		double StartTime = 0.0;
+		double EndTime = 0.0;
+		int32 NumActive = 0;
+		int32 NumSuspended = 0;
+	};
+
+	//A branch that resumed after being woken up from outside the executor
+	struct FWakeUp
+	{
+		//record of the node that resumed, if it was traced from its start
+		int32 NodeIndex = INDEX_NONE;
+		uint8 Source = 0;
+		double WakeTime = 0.0;
+		double ResumeTime = 0.0;
+		int32 Steps = 0;
+	};
+
+	explicit FCoroutinesTraceProvider(TraceServices::IAnalysisSession& InSession);
+
+	void AddName(uint32 NameId, FString const& Name);
+	void OnNodeStart(double Time, uint64 ExecutorId, uint64 NodeId, uint64 ParentId, FNodeName const& Name, uint8 Status);
+	void OnNodeSuspend(double Time, uint64 NodeId);
+	void OnNodeResume(double Time, uint64 NodeId);
+	void OnNodeEnd(double Time, uint64 NodeId, uint8 Status);
+	void OnExecutorStep(FExecutorStep const& Step);
+	void OnWakeUp(uint64 NodeId, FWakeUp WakeUp);
+
+	TArrayView<const FNodeRecord> GetNodes() const { return Nodes; }
+	TArrayView<const FExecutorStep> GetExecutorSteps() const { return Steps; }
+	TArrayView<const FWakeUp> GetWakeUps() const { return WakeUps; }
+	FString const& GetName(uint32 NameId) const;
+	//The interned name with its numeric parameter, if any, filled in
+	FString FormatName(FNodeName const& Name) const;
+
+	//One row per node record, in start order, with the index of its parent's row
+	bool WriteNodesReport(FString const& Path) const;
+	bool WriteExecutorStepsReport(FString const& Path) const;
+	bool WriteWakeUpsReport(FString const& Path) const;
+
+private:
+	FNodeRecord* FindLiveNode(uint64 NodeId);
+
+	TraceServices::IAnalysisSession& Session;
+	TArray<FNodeRecord> Nodes;
+	TMap<uint64, int32> LiveNodes;
+	TArray<FExecutorStep> Steps;
+	TArray<FWakeUp> WakeUps;
+	TMap<uint32, FString> Names;
+};
+
+#endif
@@ -7,6 +7,7 @@
 #include "CoroutinesWorldSubsystem.h"
 #include "CoroutinesSubsystem.h"
 #include "CoroutineAsync.h"
+#include "CoroutineRateLimit.h"
 #include "CoroutineSemaphores.h"
 #include "DrawDebugHelpers.h"
 
@@ -177,6 +178,23 @@ void SemaphoreTest()
 	UCoroutinesSubsystem::Get().StartCoroutine(_Main);
 }
 
+void RateLimitTest()
+{
+	//At most 2 branches per second will get through, after an initial burst of 3
+	auto RateLimiter = MakeRateLimiter(2.0f, 3);
+	auto _Main = _Sync();
+	for (int i = 0; i < 10; ++i)
+	{
+		_Main->AddChild(
+			_RateLimit(RateLimiter)
+			(
+				[=] { UE_LOG(LogTemp, Log, TEXT("Rate limited instance %d went through at %.2f"), i+1, FPlatformTime::Seconds()); }
+			)
+		);
+	}
+	UCoroutinesSubsystem::Get().StartCoroutine(_Main);
+}
+
 void ACoroutineTest::BeginPlay()
 {
 	Super::BeginPlay();
@@ -184,7 +202,8 @@ void ACoroutineTest::BeginPlay()
 	UCoroutinesWorldSubsystem::Get(this).StartCoroutine(
 		_Seq(
 			_CoroutineTest(GetWorld(), TEXT("test string")),
-			[=] { SemaphoreTest(); }
+			[=] { SemaphoreTest(); },
+			[=] { RateLimitTest(); }
 		)
 	);
 }